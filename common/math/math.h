@@ -50,6 +50,21 @@ namespace embree
     union { float f; int i; } v; v.i = i; return v.f;
   }
 
+  /*! converts a 16-bit half precision float to single precision */
+  __forceinline float half_to_float(const unsigned short h)
+  {
+#if defined(__F16C__)
+    return _cvtsh_ss(h);
+#else
+    const unsigned int sign = unsigned(h & 0x8000) << 16;
+    const unsigned int exp  = (h >> 10) & 0x1f;
+    const unsigned int mant = h & 0x3ff;
+    if (exp == 0x1f) return cast_i2f(int(sign | 0x7f800000 | (mant << 13))); // infinity and NaN
+    if (exp == 0) { const float f = float(mant)*(1.0f/16777216.0f); return sign ? -f : f; } // zero and denormals
+    return cast_i2f(int(sign | ((exp+112) << 23) | (mant << 13)));
+#endif
+  }
+
 #if defined(__WIN32__)
   __forceinline bool finite ( const float x ) { return _finite(x) != 0; }
 #endif
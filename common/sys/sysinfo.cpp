@@ -386,6 +386,22 @@ namespace embree
     return nThreads;
   }
 
+  unsigned int getNumberOfNumaNodes()
+  {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return highestNode+1;
+  }
+
+  unsigned int getNumaNodeOfCurrentThread()
+  {
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    if (!GetNumaProcessorNodeEx(&processor,&node)) return 0;
+    return node;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -432,6 +448,7 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
 
 namespace embree
 {
@@ -460,6 +477,63 @@ namespace embree
     buffer >> virt >> resident >> shared;
     return resident*sysconf(_SC_PAGE_SIZE);
   }
+
+  /* parses a list of CPUs or nodes like "0-3,8-11" as used by sysfs */
+  static std::vector<unsigned int> parseList(const std::string& fileName)
+  {
+    std::vector<unsigned int> list;
+    std::ifstream fs(fileName.c_str());
+    unsigned int begin, end;
+    while (fs >> begin)
+    {
+      end = begin;
+      if (fs.peek() == '-') {
+        fs.ignore();
+        if (!(fs >> end)) break;
+      }
+      for (unsigned int i=begin; i<=end; i++)
+        list.push_back(i);
+      if (fs.peek() == ',')
+        fs.ignore();
+    }
+    return list;
+  }
+
+  /* maps each CPU to its NUMA node, empty if the system has no NUMA topology information */
+  static const std::vector<unsigned int>& getCPUToNumaNodeMapping()
+  {
+    static const std::vector<unsigned int> cpuToNode = [] ()
+    {
+      std::vector<unsigned int> cpuToNode;
+      for (unsigned int node : parseList("/sys/devices/system/node/online"))
+      {
+        for (unsigned int cpu : parseList("/sys/devices/system/node/node" + toString(node) + "/cpulist")) {
+          if (cpu >= cpuToNode.size()) cpuToNode.resize(cpu+1,0);
+          cpuToNode[cpu] = node;
+        }
+      }
+      return cpuToNode;
+    }();
+    return cpuToNode;
+  }
+
+  unsigned int getNumberOfNumaNodes()
+  {
+    static const unsigned int nNodes = [] () {
+      unsigned int n = 1;
+      for (unsigned int node : getCPUToNumaNodeMapping()) n = std::max(n,node+1);
+      return n;
+    }();
+    return nNodes;
+  }
+
+  unsigned int getNumaNodeOfCurrentThread()
+  {
+    const std::vector<unsigned int>& cpuToNode = getCPUToNumaNodeMapping();
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= cpuToNode.size()) return 0;
+    return cpuToNode[cpu];
+  }
 }
 
 #endif
@@ -474,6 +548,14 @@ namespace embree
 
 namespace embree
 {
+  unsigned int getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  unsigned int getNumaNodeOfCurrentThread() {
+    return 0;
+  }
+
   std::string getExecutableFileName()
   {
     const int mib[4] = { CTL_KERN, KERN_PROC, KERN_PROC_PATHNAME, -1 };
@@ -506,6 +588,14 @@ namespace embree
 
 namespace embree
 {
+  unsigned int getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  unsigned int getNumaNodeOfCurrentThread() {
+    return 0;
+  }
+
   std::string getExecutableFileName()
   {
     char buf[4096];
@@ -164,6 +164,12 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
+
+  /*! return the number of NUMA nodes of the system */
+  unsigned int getNumberOfNumaNodes();
+
+  /*! returns the NUMA node of the CPU the calling thread currently runs on */
+  unsigned int getNumaNodeOfCurrentThread();
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
@@ -133,6 +133,11 @@ namespace embree
     CloseHandle(HANDLE(tid));
   }
 
+  /*! releases the handle of a thread without waiting for it to terminate */
+  void detach(thread_t tid) {
+    CloseHandle(HANDLE(tid));
+  }
+
   /*! destroy a hardware thread by its handle */
   void destroyThread(thread_t tid) {
     TerminateThread(HANDLE(tid),0);
@@ -378,6 +383,13 @@ namespace embree
     delete (pthread_t*)tid;
   }
 
+  /*! releases the handle of a thread without waiting for it to terminate */
+  void detach(thread_t tid) {
+    if (pthread_detach(*(pthread_t*)tid) != 0)
+      FATAL("pthread_detach failed");
+    delete (pthread_t*)tid;
+  }
+
   /*! destroy a hardware thread by its handle */
   void destroyThread(thread_t tid) {
     pthread_cancel(*(pthread_t*)tid);
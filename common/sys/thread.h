@@ -42,6 +42,9 @@ namespace embree
   /*! waits until the given thread has terminated */
   void join(thread_t tid);
 
+  /*! releases the handle of a thread without waiting for it to terminate */
+  void detach(thread_t tid);
+
   /*! destroy handle of a thread */
   void destroyThread(thread_t tid);
 
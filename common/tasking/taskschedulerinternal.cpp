@@ -386,18 +386,27 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++)
+    /* on NUMA systems we first steal from threads of the same node, and only then from remote nodes */
+    const bool numa = getNumberOfNumaNodes() > 1;
+
+    for (size_t pass=numa ? 0 : 1; pass<2; pass++)
     {
-      pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=1; i<threadCount; i++)
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
 
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
 
-      if (othread->tasks.steal(thread))
-        return true;
+        if (numa && (othread->numaNode == thread.numaNode) != (pass == 0))
+          continue;
+
+        pause_cpu(32);
+        if (othread->tasks.steal(thread))
+          return true;
+      }
     }
 
     return false;
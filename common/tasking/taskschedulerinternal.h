@@ -20,6 +20,7 @@
 #include "../sys/alloc.h"
 #include "../sys/barrier.h"
 #include "../sys/thread.h"
+#include "../sys/sysinfo.h"
 #include "../sys/mutex.h"
 #include "../sys/condition.h"
 #include "../sys/ref.h"
@@ -176,13 +177,14 @@ namespace embree
       ALIGNED_STRUCT_(64);
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), numaNode(getNumaNodeOfCurrentThread()), task(nullptr), scheduler(scheduler) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
       }
 
       size_t threadIndex;              //!< ID of this thread
+      size_t numaNode;                 //!< NUMA node this thread started on
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
@@ -34,6 +34,28 @@ struct RTC_ALIGN(32) RTCBuildPrimitive
   unsigned int primID;
 };
 
+/* Input motion blur build primitives for the builder */
+struct RTC_ALIGN(16) RTCBuildPrimitiveMB
+{
+  struct RTCLinearBounds bounds;
+  unsigned int geomID;
+  unsigned int primID;
+  unsigned int timeSegmentCount;
+  unsigned int align0;
+};
+
+/* Flag of the count member of flat BVH nodes that marks leaves */
+#define RTC_BUILD_NODE_LEAF ((unsigned int)0x80000000)
+
+/* Node of a flat BVH written by the builder */
+struct RTC_ALIGN(32) RTCBuildNode
+{
+  float lower_x, lower_y, lower_z;
+  unsigned int offset;
+  float upper_x, upper_y, upper_z;
+  unsigned int count;
+};
+
 /* Opaque thread local allocator type */
 typedef struct RTCThreadLocalAllocatorTy* RTCThreadLocalAllocator;
 
@@ -52,11 +74,21 @@ typedef void* (*RTCCreateLeafFunction) (RTCThreadLocalAllocator allocator, const
 /* Callback to split a build primitive */
 typedef void (*RTCSplitPrimitiveFunction) (const struct RTCBuildPrimitive* primitive, unsigned int dimension, float position, struct RTCBounds* leftBounds, struct RTCBounds* rightBounds, void* userPtr);
 
+/* Callback to set a child of a motion blur node and its linear bounds over the time range of the child */
+typedef void (*RTCSetNodeChildMBFunction) (void* nodePtr, unsigned int childIndex, void* child, const struct RTCLinearBounds* bounds, float timeLower, float timeUpper, void* userPtr);
+
+/* Callback to create a motion blur leaf node for some time range */
+typedef void* (*RTCCreateLeafMBFunction) (RTCThreadLocalAllocator allocator, const struct RTCBuildPrimitiveMB* primitives, size_t primitiveCount, float timeLower, float timeUpper, void* userPtr);
+
+/* Callback to calculate the linear bounds of a motion blur build primitive for some time range */
+typedef void (*RTCPrimitiveLinearBoundsFunction) (const struct RTCBuildPrimitiveMB* primitive, float timeLower, float timeUpper, struct RTCLinearBounds* bounds, void* userPtr);
+
 /* Build flags */
 enum RTCBuildFlags
 {
   RTC_BUILD_FLAG_NONE    = 0,
   RTC_BUILD_FLAG_DYNAMIC = (1 << 0),
+  RTC_BUILD_FLAG_REFIT   = (1 << 1),
 };
   
 /* Input for builders */
@@ -86,6 +118,14 @@ struct RTCBuildArguments
   RTCSplitPrimitiveFunction splitPrimitive;
   RTCProgressMonitorFunction buildProgress;
   void* userPtr;
+
+  struct RTCBuildPrimitiveMB* primitivesMB;
+  RTCSetNodeChildMBFunction setNodeChildMB;
+  RTCCreateLeafMBFunction createLeafMB;
+  RTCPrimitiveLinearBoundsFunction primitiveLinearBounds;
+
+  struct RTCBuildNode* nodes;
+  size_t nodeArrayCapacity;
 };
 
 /* Returns the default build settings.  */
@@ -113,6 +153,12 @@ RTC_FORCEINLINE struct RTCBuildArguments rtcDefaultBuildArguments()
   args.splitPrimitive = NULL;
   args.buildProgress = NULL;
   args.userPtr = NULL;
+  args.primitivesMB = NULL;
+  args.setNodeChildMB = NULL;
+  args.createLeafMB = NULL;
+  args.primitiveLinearBounds = NULL;
+  args.nodes = NULL;
+  args.nodeArrayCapacity = 0;
   return args;
 }
 
@@ -122,6 +168,12 @@ RTC_API RTCBVH rtcNewBVH(RTCDevice device);
 /* Builds a BVH. */
 RTC_API void* rtcBuildBVH(const struct RTCBuildArguments* args);
 
+/* Returns the number of nodes written by the last flat BVH build. */
+RTC_API size_t rtcGetBVHNodeCount(RTCBVH bvh);
+
+/* Refits a BVH built with RTC_BUILD_FLAG_REFIT to new bounds of its primitives. */
+RTC_API void rtcRefitBVH(RTCBVH bvh, const struct RTCBuildPrimitive* primitives, RTCSetNodeBoundsFunction setNodeBounds, void* userPtr);
+
 /* Allocates memory using the thread local allocator. */
 RTC_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator allocator, size_t bytes, size_t align);
 
@@ -20,6 +20,8 @@
 #include <sys/types.h>
 #include <stdbool.h>
 
+#include "rtcore_config.h"
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -68,9 +70,6 @@ typedef int ssize_t;
 /* Maximum number of time steps */
 #define RTC_MAX_TIME_STEP_COUNT 129
 
-/* Maximum number of instancing levels */
-#define RTC_MAX_INSTANCE_LEVEL_COUNT 1
-
 /* Formats of buffers and other data structures */
 enum RTCFormat
 {
@@ -165,7 +164,13 @@ enum RTCFormat
   RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR = 0x9244,
 
   /* special 12-byte format for grids */
-  RTC_FORMAT_GRID = 0xA001
+  RTC_FORMAT_GRID = 0xA001,
+
+  /* 16-bit half precision float */
+  RTC_FORMAT_HALF = 0xB001,
+  RTC_FORMAT_HALF2,
+  RTC_FORMAT_HALF3,
+  RTC_FORMAT_HALF4
 };
 
 /* Build quality levels */
@@ -196,7 +201,19 @@ enum RTCIntersectContextFlags
 {
   RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
   RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_STATISTICS = (1 << 1), // gather traversal statistics
+  RTC_INTERSECT_CONTEXT_FLAG_TRANSMITTANCE = (1 << 2) // accumulate transmittance of transparent geometries in occlusion queries
+};
+
+/* Traversal statistics gathered when RTC_INTERSECT_CONTEXT_FLAG_STATISTICS is set */
+struct RTCTraversalStatistics
+{
+  unsigned int nodes;      // number of inner nodes traversed
+  unsigned int leaves;     // number of leaf nodes visited
+  unsigned int primitives; // number of primitive blocks intersected
+  unsigned int filters;    // number of filter function invocations
+  unsigned int instances;  // number of instances entered
 };
 
 /* Arguments for RTCFilterFunctionN */
@@ -218,7 +235,13 @@ struct RTCIntersectContext
 {
   enum RTCIntersectContextFlags flags;               // intersection flags
   RTCFilterFunctionN filter;                         // filter function to execute
-  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // will be set to geomID of instance when instance is entered
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+  unsigned int instStackSize;                        // number of instances currently on the instance ID stack
+#endif
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // stack of geomIDs of entered instances, outermost first
+  struct RTCTraversalStatistics* stats;              // traversal statistics to fill
+  float* transmittance;                              // transmittance of the rays, indexed by ray ID
+  float minTransmittance;                            // rays with lower transmittance are occluded
 };
 
 /* Initializes an intersection context. */
@@ -226,7 +249,14 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
 {
   context->flags = RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT;
   context->filter = NULL;
-  context->instID[0] = RTC_INVALID_GEOMETRY_ID;
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+  context->instStackSize = 0;
+#endif
+  for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    context->instID[l] = RTC_INVALID_GEOMETRY_ID;
+  context->stats = NULL;
+  context->transmittance = NULL;
+  context->minTransmittance = 0.0f;
 }
   
 #if defined(__cplusplus)
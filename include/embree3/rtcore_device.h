@@ -59,7 +59,11 @@ enum RTCDeviceProperty
   RTC_DEVICE_PROPERTY_USER_GEOMETRY_SUPPORTED        = 100,
 
   RTC_DEVICE_PROPERTY_TASKING_SYSTEM        = 128,
-  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129
+  RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED = 129,
+
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS      = 160,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES    = 161,
+  RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS = 162
 };
 
 /* Gets a device property. */
@@ -162,6 +162,9 @@ RTC_API void rtcSetGeometryVertexAttributeCount(RTCGeometry geometry, unsigned i
 /* Sets the ray mask of the geometry. */
 RTC_API void rtcSetGeometryMask(RTCGeometry geometry, unsigned int mask);
 
+/* Sets the constant opacity of the geometry used in occlusion queries that accumulate transmittance. */
+RTC_API void rtcSetGeometryOpacity(RTCGeometry geometry, float opacity);
+
 /* Sets the build quality of the geometry. */
 RTC_API void rtcSetGeometryBuildQuality(RTCGeometry geometry, enum RTCBuildQuality quality);
 
@@ -181,6 +184,9 @@ RTC_API void* rtcGetGeometryBufferData(RTCGeometry geometry, enum RTCBufferType
 /* Updates a geometry buffer. */
 RTC_API void rtcUpdateGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot);
 
+/* Sets the dequantization transformation of half precision or 16-bit quantized vertex buffers. */
+RTC_API void rtcSetGeometryVertexDequantization(RTCGeometry geometry, const float* scale, const float* offset);
+
 
 /* Sets the intersection filter callback function of the geometry. */
 RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
@@ -227,6 +233,9 @@ RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCF
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Enables view dependent tessellation of a subdivision geometry for the specified camera position, or disables it if the position is NULL. */
+RTC_API void rtcSetGeometryAdaptiveTessellation(RTCGeometry geometry, const float* position, float minLevel, float maxLevel);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
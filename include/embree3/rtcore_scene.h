@@ -36,7 +36,8 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_QUANTIZED               = (1 << 4)
 };
 
 /* Creates a new scene. */
@@ -68,6 +69,18 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Scene commit completion callback function */
+typedef void (*RTCCommitSceneFunction)(void* userPtr, enum RTCError error);
+
+/* Commits the scene asynchronously and invokes the callback when the commit finished. */
+RTC_API void rtcCommitSceneAsync(RTCScene scene, RTCCommitSceneFunction callback, void* userPtr);
+
+/* Saves the acceleration structures of a committed scene to a file. */
+RTC_API void rtcSaveScene(RTCScene scene, const char* filename);
+
+/* Commits the scene using acceleration structures loaded from a file. */
+RTC_API void rtcLoadScene(RTCScene scene, const char* filename);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -138,6 +151,61 @@ RTC_API void rtcOccludedNM(RTCScene scene, struct RTCIntersectContext* context,
 /* Tests a stream of M ray packets of size N in SOA format for occlusion with the scene. */
 RTC_API void rtcOccludedNp(RTCScene scene, struct RTCIntersectContext* context, const struct RTCRayNp* ray, unsigned int N);
 
+/* Point query structure */
+struct RTC_ALIGN(16) RTCPointQuery
+{
+  float x;      // x coordinate of the query point
+  float y;      // y coordinate of the query point
+  float z;      // z coordinate of the query point
+  float time;   // time of the point query
+  float radius; // radius of the point query
+};
+
+/* Arguments for RTCPointQueryFunction callback */
+struct RTCPointQueryFunctionArguments
+{
+  struct RTCPointQuery* query; // point query, the callback may reduce its radius
+  void* userPtr;
+  unsigned int primID;
+  unsigned int geomID;
+};
+
+/* Point query callback function, returns true if the query radius got reduced */
+typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
+
+/* Invokes the callback for all primitives near the query point. */
+RTC_API bool rtcPointQuery(RTCScene scene, struct RTCPointQuery* query, RTCPointQueryFunction queryFunc, void* userPtr);
+
+/* Closest point structure */
+struct RTCClosestPoint
+{
+  float p_x;           // x coordinate of the closest point
+  float p_y;           // y coordinate of the closest point
+  float p_z;           // z coordinate of the closest point
+  float u;             // barycentric u coordinate of the closest point
+  float v;             // barycentric v coordinate of the closest point
+  unsigned int primID; // primitive ID of the closest point
+  unsigned int geomID; // geometry ID of the closest point
+};
+
+/* Finds the closest point on the triangle and quad geometries of the scene. */
+RTC_API bool rtcClosestPoint(RTCScene scene, struct RTCPointQuery* query, struct RTCClosestPoint* result);
+
+/* Collision structure */
+struct RTCCollision
+{
+  unsigned int geomID0; // geometry ID of the primitive of the first scene
+  unsigned int primID0; // primitive ID of the primitive of the first scene
+  unsigned int geomID1; // geometry ID of the primitive of the second scene
+  unsigned int primID1; // primitive ID of the primitive of the second scene
+};
+
+/* Collision callback function, invoked with batches of overlapping primitive pairs */
+typedef void (*RTCCollideFunction)(void* userPtr, struct RTCCollision* collisions, unsigned int num_collisions);
+
+/* Reports all pairs of primitives of two scenes whose bounds overlap. */
+RTC_API void rtcCollide(RTCScene scene0, RTCScene scene1, RTCCollideFunction callback, void* userPtr);
+
 #if defined(__cplusplus)
 
 /* Helper for easily combining scene flags */
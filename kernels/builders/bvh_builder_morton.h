@@ -59,6 +59,9 @@ namespace embree
       /*! Build primitive consisting of morton code and primitive ID. */
       struct __aligned(8) BuildPrim
       {
+        typedef unsigned int Code;
+        static const size_t LATTICE_BITS_PER_DIM = 10;
+
         union {
           struct {
             unsigned int code;     //!< morton code
@@ -67,6 +70,11 @@ namespace embree
           uint64_t t;
         };
 
+        /*! interleaves the lattice coordinates into a morton code */
+        static __forceinline Code encode(const unsigned int x, const unsigned int y, const unsigned int z) {
+          return bitInterleave(x,y,z);
+        }
+
         /*! interface for radix sort */
         __forceinline operator unsigned() const { return code; }
 
@@ -74,16 +82,39 @@ namespace embree
         __forceinline bool operator<(const BuildPrim &m) const { return code < m.code; }
       };
 
+      /*! Build primitive with 64 bit morton code, used for large meshes where 10 bits per dimension are too coarse. */
+      struct __aligned(16) BuildPrim64
+      {
+        typedef uint64_t Code;
+        static const size_t LATTICE_BITS_PER_DIM = 21;
+
+        uint64_t code;         //!< morton code
+        unsigned int index;    //!< i'th primitive
+
+        /*! interleaves the lattice coordinates into a morton code */
+        static __forceinline Code encode(const unsigned int x, const unsigned int y, const unsigned int z) {
+          return bitInterleave64<uint64_t>(x,y,z);
+        }
+
+        /*! interface for radix sort */
+        __forceinline operator uint64_t() const { return code; }
+
+        /*! interface for standard sort */
+        __forceinline bool operator<(const BuildPrim64 &m) const { return code < m.code; }
+      };
+
       /*! maps bounding box to morton code */
-      struct MortonCodeMapping
+      template<typename BuildPrimT>
+      struct MortonCodeMappingT
       {
-        static const size_t LATTICE_BITS_PER_DIM = 10;
+        typedef typename BuildPrimT::Code Code;
+        static const size_t LATTICE_BITS_PER_DIM = BuildPrimT::LATTICE_BITS_PER_DIM;
         static const size_t LATTICE_SIZE_PER_DIM = size_t(1) << LATTICE_BITS_PER_DIM;
 
         vfloat4 base;
         vfloat4 scale;
 
-        __forceinline MortonCodeMapping(const BBox3fa& bounds)
+        __forceinline MortonCodeMappingT(const BBox3fa& bounds)
         {
           base  = (vfloat4)bounds.lower;
           const vfloat4 diag  = (vfloat4)bounds.upper - (vfloat4)bounds.lower;
@@ -98,17 +129,20 @@ namespace embree
           return vint4((centroid-base)*scale);
         }
 
-        __forceinline unsigned int code (const BBox3fa& box) const
+        __forceinline Code code (const BBox3fa& box) const
         {
           const vint4 binID = bin(box);
           const unsigned int x = extract<0>(binID);
           const unsigned int y = extract<1>(binID);
           const unsigned int z = extract<2>(binID);
-          const unsigned int xyz = bitInterleave(x,y,z);
+          const Code xyz = BuildPrimT::encode(x,y,z);
           return xyz;
         }
       };
 
+      typedef MortonCodeMappingT<BuildPrim> MortonCodeMapping;
+      typedef MortonCodeMappingT<BuildPrim64> MortonCodeMapping64;
+
 #if defined (__AVX2__)
 
       /*! for AVX2 there is a fast scalar bitInterleave */
@@ -179,8 +213,27 @@ namespace embree
 
 #endif
 
+      /*! generates 64 bit morton codes one primitive at a time */
+      struct MortonCodeGenerator64
+      {
+        __forceinline MortonCodeGenerator64(const MortonCodeMapping64& mapping, BuildPrim64* dest)
+          : mapping(mapping), dest(dest) {}
+
+        __forceinline void operator() (const BBox3fa& b, const unsigned index)
+        {
+          dest->index = index;
+          dest->code = mapping.code(b);
+          dest++;
+        }
+
+      public:
+        const MortonCodeMapping64 mapping;
+        BuildPrim64* dest;
+      };
+
       template<
         typename ReductionTy,
+        typename BuildPrimT,
         typename Allocator,
         typename CreateAllocator,
         typename CreateNodeFunc,
@@ -280,7 +333,7 @@ namespace embree
               centBounds.extend(center2(calculateBounds(morton[i])));
 
             /* recalculate morton codes */
-            MortonCodeMapping mapping(centBounds);
+            MortonCodeMappingT<BuildPrimT> mapping(centBounds);
             for (size_t i=current.begin(); i<current.end(); i++)
               morton[i].code = mapping.code(calculateBounds(morton[i]));
 
@@ -300,7 +353,7 @@ namespace embree
                                                        BBox3fa(empty), calculateCentBounds, BBox3fa::merge);
 
             /* recalculate morton codes */
-            MortonCodeMapping mapping(centBounds);
+            MortonCodeMappingT<BuildPrimT> mapping(centBounds);
             parallel_for(current.begin(), current.end(), unsigned(1024), [&] ( const range<unsigned>& r ) {
                 for (size_t i=r.begin(); i<r.end(); i++) {
                   morton[i].code = mapping.code(calculateBounds(morton[i]));
@@ -311,42 +364,57 @@ namespace embree
 #if defined(TASKING_TBB)
             tbb::parallel_sort(morton+current.begin(),morton+current.end());
 #else
-            radixsort32(morton+current.begin(),current.size());
+            if (sizeof(typename BuildPrimT::Code) == sizeof(unsigned int))
+              radixsort32(morton+current.begin(),current.size());
+            else
+              std::sort(morton+current.begin(),morton+current.end());
 #endif
           }
         }
 
+        /*! counts the leading zero bits of 32 and 64 bit morton codes */
+        static __forceinline unsigned int leadingZeros(const unsigned int x) {
+          return lzcnt(x);
+        }
+
+        static __forceinline unsigned int leadingZeros(const uint64_t x) {
+          const unsigned int hi = (unsigned int)(x >> 32);
+          return hi ? lzcnt(hi) : 32+lzcnt((unsigned int)x);
+        }
+
         __forceinline void split(const range<unsigned>& current, range<unsigned>& left, range<unsigned>& right) const
         {
-          const unsigned int code_start = morton[current.begin()].code;
-          const unsigned int code_end   = morton[current.end()-1].code;
-          unsigned int bitpos = lzcnt(code_start^code_end);
+          typedef typename BuildPrimT::Code Code;
+          const unsigned int CODE_BITS = 8*sizeof(Code);
+          const Code code_start = morton[current.begin()].code;
+          const Code code_end   = morton[current.end()-1].code;
+          unsigned int bitpos = leadingZeros(code_start^code_end);
 
           /* if all items mapped to same morton code, then re-create new morton codes for the items */
-          if (unlikely(bitpos == 32))
+          if (unlikely(bitpos == CODE_BITS))
           {
             recreateMortonCodes(current);
-            const unsigned int code_start = morton[current.begin()].code;
-            const unsigned int code_end   = morton[current.end()-1].code;
-            bitpos = lzcnt(code_start^code_end);
+            const Code code_start = morton[current.begin()].code;
+            const Code code_end   = morton[current.end()-1].code;
+            bitpos = leadingZeros(code_start^code_end);
 
             /* if the morton code is still the same, goto fall back split */
-            if (unlikely(bitpos == 32)) {
+            if (unlikely(bitpos == CODE_BITS)) {
               current.split(left,right);
               return;
             }
           }
 
           /* split the items at the topmost different morton code bit */
-          const unsigned int bitpos_diff = 31-bitpos;
-          const unsigned int bitmask = 1 << bitpos_diff;
+          const unsigned int bitpos_diff = CODE_BITS-1-bitpos;
+          const Code bitmask = Code(1) << bitpos_diff;
 
           /* find location where bit differs using binary search */
           unsigned begin = current.begin();
           unsigned end   = current.end();
           while (begin + 1 != end) {
             const unsigned mid = (begin+end)/2;
-            const unsigned bit = morton[mid].code & bitmask;
+            const Code bit = morton[mid].code & bitmask;
             if (bit == 0) begin = mid; else end = mid;
           }
           unsigned center = end;
@@ -439,11 +507,11 @@ namespace embree
         }
 
         /* build function */
-        ReductionTy build(BuildPrim* src, BuildPrim* tmp, size_t numPrimitives)
+        ReductionTy build(BuildPrimT* src, BuildPrimT* tmp, size_t numPrimitives)
         {
           /* sort morton codes */
           morton = src;
-          radix_sort_u32(src,tmp,numPrimitives,singleThreadThreshold);
+          radix_sort<BuildPrimT,typename BuildPrimT::Code>(src,tmp,numPrimitives,singleThreadThreshold);
 
           /* build BVH */
           const ReductionTy root = recurse(1, range<unsigned>(0,(unsigned)numPrimitives), nullptr, true);
@@ -460,12 +528,13 @@ namespace embree
         ProgressMonitor& progressMonitor;
 
       public:
-        BuildPrim* morton;
+        BuildPrimT* morton;
       };
 
 
       template<
       typename ReductionTy,
+        typename BuildPrimT,
         typename CreateAllocFunc,
         typename CreateNodeFunc,
         typename SetBoundsFunc,
@@ -479,13 +548,14 @@ namespace embree
                                  CreateLeafFunc createLeaf,
                                  CalculateBoundsFunc calculateBounds,
                                  ProgressMonitor progressMonitor,
-                                 BuildPrim* src,
-                                 BuildPrim* tmp,
+                                 BuildPrimT* src,
+                                 BuildPrimT* tmp,
                                  size_t numPrimitives,
                                  const Settings& settings)
         {
           typedef BuilderT<
             ReductionTy,
+            BuildPrimT,
             decltype(createAllocator()),
             CreateAllocFunc,
             CreateNodeFunc,
@@ -505,5 +575,23 @@ namespace embree
           return builder.build(src,tmp,numPrimitives);
         }
     };
+
+    /*! selects the morton code mapping and generator for some build primitive type */
+    template<typename BuildPrimT>
+      struct MortonCodeTraits;
+
+    template<>
+      struct MortonCodeTraits<BVHBuilderMorton::BuildPrim>
+    {
+      typedef BVHBuilderMorton::MortonCodeMapping Mapping;
+      typedef BVHBuilderMorton::MortonCodeGenerator Generator;
+    };
+
+    template<>
+      struct MortonCodeTraits<BVHBuilderMorton::BuildPrim64>
+    {
+      typedef BVHBuilderMorton::MortonCodeMapping64 Mapping;
+      typedef BVHBuilderMorton::MortonCodeGenerator64 Generator;
+    };
   }
 }
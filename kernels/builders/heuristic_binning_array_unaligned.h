@@ -22,14 +22,106 @@ namespace embree
 {
   namespace isa
   { 
+    /*! direction of the curve with minimum ID that defines a valid direction */
+    struct UnalignedAxis
+    {
+      __forceinline UnalignedAxis ()
+        : axis(0,0,1), geomprimID(-1) {}
+
+      __forceinline UnalignedAxis (const Vec3fa& axis, uint64_t geomprimID)
+        : axis(axis), geomprimID(geomprimID) {}
+
+      /*! selects the axis of the curve with smaller ID, which keeps the parallel reduction deterministic */
+      static __forceinline const UnalignedAxis merge (const UnalignedAxis& a, const UnalignedAxis& b) {
+        return a.geomprimID <= b.geomprimID ? a : b;
+      }
+
+    public:
+      Vec3fa axis;          //!< normalized direction of the curve
+      uint64_t geomprimID;  //!< combined geometry and primitive ID of the curve
+    };
+
+#if defined(__AVX512F__)
+
+    /*! bins primitives in unaligned space, maps the centers of 16 primitives at once to their bins */
+    template<size_t BINS, typename PrimRef>
+      struct __aligned(64) UnalignedBinInfo16 : public BinInfoT<BINS,PrimRef,BBox3fa>
+    {
+      typedef BinInfoT<BINS,PrimRef,BBox3fa> Base;
+
+      __forceinline UnalignedBinInfo16() {
+      }
+
+      __forceinline UnalignedBinInfo16(EmptyTy)
+        : Base(empty) {}
+
+      /*! bins an array of primitives */
+      template<typename BinBoundsAndCenter>
+        __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping, const BinBoundsAndCenter& binBoundsAndCenter)
+      {
+        const vfloat16 ofs_x(mapping.ofs[0]), ofs_y(mapping.ofs[1]), ofs_z(mapping.ofs[2]);
+        const vfloat16 scale_x(mapping.scale[0]), scale_y(mapping.scale[1]), scale_z(mapping.scale[2]);
+
+        for (size_t i=0; i<N; i+=16)
+        {
+          const size_t n = min(N-i,size_t(16));
+
+          /* calculate bounds of up to 16 primitives in unaligned space */
+          BBox3fa prim[16];
+          __aligned(64) float cx[16], cy[16], cz[16];
+          for (size_t j=0; j<n; j++) {
+            Vec3fa center; binBoundsAndCenter.binBoundsAndCenter(prims[i+j],prim[j],center);
+            cx[j] = center.x; cy[j] = center.y; cz[j] = center.z;
+          }
+
+          /* map all centers to bins at once */
+          const vboolf16 valid = vint16(step) < vint16(int(n));
+          __aligned(64) int bx[16], by[16], bz[16];
+          vint16::store(bx,floori((vfloat16::load(valid,cx)-ofs_x)*scale_x));
+          vint16::store(by,floori((vfloat16::load(valid,cy)-ofs_y)*scale_y));
+          vint16::store(bz,floori((vfloat16::load(valid,cz)-ofs_z)*scale_z));
+
+          /* increase bounds of bins */
+          for (size_t j=0; j<n; j++)
+          {
+            const unsigned int s = prims[i+j].size();
+            this->counts(bx[j],0) += s; this->bounds(bx[j],0).extend(prim[j]);
+            this->counts(by[j],1) += s; this->bounds(by[j],1).extend(prim[j]);
+            this->counts(bz[j],2) += s; this->bounds(bz[j],2).extend(prim[j]);
+          }
+        }
+      }
+
+      template<typename BinBoundsAndCenter>
+        __forceinline void bin(const PrimRef* prims, size_t begin, size_t end, const BinMapping<BINS>& mapping, const BinBoundsAndCenter& binBoundsAndCenter) {
+	bin<BinBoundsAndCenter>(prims+begin,end-begin,mapping,binBoundsAndCenter);
+      }
+    };
+
+#endif
+
     /*! Performs standard object binning */
     template<typename PrimRef, size_t BINS>
       struct UnalignedHeuristicArrayBinningSAH
       {
         typedef BinSplit<BINS> Split;
+#if defined(__AVX512F__)
+        typedef UnalignedBinInfo16<BINS,PrimRef> Binner;
+#else
         typedef BinInfoT<BINS,PrimRef,BBox3fa> Binner;
+#endif
         typedef range<size_t> Set;
 
+#if defined(__AVX512ER__) // KNL
+        static const size_t PARALLEL_THRESHOLD = 4*768; 
+        static const size_t PARALLEL_FIND_BLOCK_SIZE = 768;
+        static const size_t PARALLEL_PARTITION_BLOCK_SIZE = 768;
+#else
+        static const size_t PARALLEL_THRESHOLD = 3 * 1024;
+        static const size_t PARALLEL_FIND_BLOCK_SIZE = 1024;
+        static const size_t PARALLEL_PARTITION_BLOCK_SIZE = 128;
+#endif
+
         __forceinline UnalignedHeuristicArrayBinningSAH () // FIXME: required?
           : scene(nullptr), prims(nullptr) {}
         
@@ -39,23 +131,26 @@ namespace embree
 
         const LinearSpace3fa computeAlignedSpace(const range<size_t>& set)
         {
-          Vec3fa axis(0,0,1);
-          uint64_t bestGeomPrimID = -1;
-
           /*! find curve with minimum ID that defines valid direction */
-          for (size_t i=set.begin(); i<set.end(); i++)
-          {
-            const unsigned int geomID = prims[i].geomID();
-            const unsigned int primID = prims[i].primID();
-            const uint64_t geomprimID = prims[i].ID64();
-            if (geomprimID >= bestGeomPrimID) continue;
-            const Vec3fa axis1 = scene->get(geomID)->computeDirection(primID);
-            if (sqr_length(axis1) > 1E-18f) {
-              axis = normalize(axis1);
-              bestGeomPrimID = geomprimID;
-            }
-          }
-          return frame(axis).transposed();
+          auto findAxis = [&] (const range<size_t>& r) -> UnalignedAxis
+            {
+              UnalignedAxis best;
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                const unsigned int geomID = prims[i].geomID();
+                const unsigned int primID = prims[i].primID();
+                const uint64_t geomprimID = prims[i].ID64();
+                if (geomprimID >= best.geomprimID) continue;
+                const Vec3fa axis1 = scene->get(geomID)->computeDirection(primID);
+                if (sqr_length(axis1) > 1E-18f)
+                  best = UnalignedAxis(normalize(axis1),geomprimID);
+              }
+              return best;
+            };
+
+          const UnalignedAxis best = parallel_reduce(set.begin(), set.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
+                                                     UnalignedAxis(), findAxis, UnalignedAxis::merge);
+          return frame(best.axis).transposed();
         }
         
         const PrimInfo computePrimInfo(const range<size_t>& set, const LinearSpace3fa& space)
@@ -70,7 +165,7 @@ namespace embree
               return bounds;
             };
           
-          const CentGeomBBox3fa bounds = parallel_reduce(set.begin(), set.end(), size_t(1024), size_t(4096), 
+          const CentGeomBBox3fa bounds = parallel_reduce(set.begin(), set.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
                                                          CentGeomBBox3fa(empty), computeBounds, CentGeomBBox3fa::merge2);
 
           return PrimInfo(set.begin(),set.end(),bounds);
@@ -106,7 +201,7 @@ namespace embree
         /*! finds the best split */
         __forceinline const Split find(const PrimInfoRange& pinfo, const size_t logBlockSize, const LinearSpace3fa& space)
         {
-          if (likely(pinfo.size() < 10000))
+          if (likely(pinfo.size() < PARALLEL_THRESHOLD))
             return find_template<false>(pinfo,logBlockSize,space);
           else
             return find_template<true>(pinfo,logBlockSize,space);
@@ -119,14 +214,14 @@ namespace embree
           Binner binner(empty);
           const BinMapping<BINS> mapping(set);
           BinBoundsAndCenter binBoundsAndCenter(scene,space);
-          bin_serial_or_parallel<parallel>(binner,prims,set.begin(),set.end(),size_t(4096),mapping,binBoundsAndCenter);
+          bin_serial_or_parallel<parallel>(binner,prims,set.begin(),set.end(),PARALLEL_FIND_BLOCK_SIZE,mapping,binBoundsAndCenter);
           return binner.best(mapping,logBlockSize);
         }
         
         /*! array partitioning */
         __forceinline void split(const Split& split, const LinearSpace3fa& space, const Set& set, PrimInfoRange& lset, PrimInfoRange& rset)
         {
-          if (likely(set.size() < 10000))
+          if (likely(set.size() < PARALLEL_THRESHOLD))
             split_template<false>(split,space,set,lset,rset);
           else
             split_template<true>(split,space,set,lset,rset);
@@ -150,7 +245,7 @@ namespace embree
           BinBoundsAndCenter binBoundsAndCenter(scene,space);
 
           size_t center = 0;
-          if (likely(set.size() < 10000))
+          if (!parallel)
             center = serial_partitioning(prims,begin,end,local_left,local_right,
                                          [&] (const PrimRef& ref) { return split.mapping.bin_unsafe(ref,binBoundsAndCenter)[splitDim] < splitPos; },
                                          [] (CentGeomBBox3fa& pinfo,const PrimRef& ref) { pinfo.extend_center2(ref); });
@@ -159,7 +254,7 @@ namespace embree
                                            [&] (const PrimRef& ref) { return split.mapping.bin_unsafe(ref,binBoundsAndCenter)[splitDim] < splitPos; },
                                            [] (CentGeomBBox3fa& pinfo,const PrimRef& ref) { pinfo.extend_center2(ref); },
                                            [] (CentGeomBBox3fa& pinfo0,const CentGeomBBox3fa& pinfo1) { pinfo0.merge(pinfo1); },
-                                           128);
+                                           PARALLEL_PARTITION_BLOCK_SIZE);
           
           new (&lset) PrimInfoRange(begin,center,local_left);
           new (&rset) PrimInfoRange(center,end,local_right);
@@ -212,32 +307,34 @@ namespace embree
 
         const LinearSpace3fa computeAlignedSpaceMB(Scene* scene, const SetMB& set)
         {
-          Vec3fa axis0(0,0,1);
-          uint64_t bestGeomPrimID = -1;
-
           /*! find curve with minimum ID that defines valid direction */
-          for (size_t i=set.object_range.begin(); i<set.object_range.end(); i++)
-          {
-            const PrimRefMB& prim = (*set.prims)[i];
-            const unsigned int geomID = prim.geomID();
-            const unsigned int primID = prim.primID();
-            const uint64_t geomprimID = prim.ID64();
-            if (geomprimID >= bestGeomPrimID) continue;
-            
-            const Geometry* mesh = scene->get(geomID);
-            const unsigned num_time_segments = mesh->numTimeSegments();
-            const range<int> tbounds = getTimeSegmentRange(set.time_range, (float)num_time_segments);
-            if (tbounds.size() == 0) continue;
-
-            const size_t t = (tbounds.begin()+tbounds.end())/2;
-            const Vec3fa axis1 = mesh->computeDirection(primID,t);
-            if (sqr_length(axis1) > 1E-18f) {
-              axis0 = normalize(axis1);
-              bestGeomPrimID = geomprimID;
-            }
-          }
+          auto findAxis = [&] (const range<size_t>& r) -> UnalignedAxis
+            {
+              UnalignedAxis best;
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                const PrimRefMB& prim = (*set.prims)[i];
+                const unsigned int geomID = prim.geomID();
+                const unsigned int primID = prim.primID();
+                const uint64_t geomprimID = prim.ID64();
+                if (geomprimID >= best.geomprimID) continue;
+
+                const Geometry* mesh = scene->get(geomID);
+                const unsigned num_time_segments = mesh->numTimeSegments();
+                const range<int> tbounds = getTimeSegmentRange(set.time_range, (float)num_time_segments);
+                if (tbounds.size() == 0) continue;
+
+                const size_t t = (tbounds.begin()+tbounds.end())/2;
+                const Vec3fa axis1 = mesh->computeDirection(primID,t);
+                if (sqr_length(axis1) > 1E-18f)
+                  best = UnalignedAxis(normalize(axis1),geomprimID);
+              }
+              return best;
+            };
 
-          return frame(axis0).transposed();
+          const UnalignedAxis best = parallel_reduce(set.object_range.begin(), set.object_range.end(), PARALLEL_FIND_BLOCK_SIZE, PARALLEL_THRESHOLD,
+                                                     UnalignedAxis(), findAxis, UnalignedAxis::merge);
+          return frame(best.axis).transposed();
         }
 
         struct BinBoundsAndCenter
@@ -34,8 +34,8 @@ namespace embree
 
     PrimInfoMB createPrimRefArrayMSMBlur(Scene* scene, Geometry::GTypeMask types, mvector<PrimRefMB>& prims, BuildProgressMonitor& progressMonitor, BBox1f t0t1 = BBox1f(0.0f,1.0f));
 
-    template<typename Mesh>
-      size_t createMortonCodeArray(Mesh* mesh, mvector<BVHBuilderMorton::BuildPrim>& morton, BuildProgressMonitor& progressMonitor);
+    template<typename Mesh, typename BuildPrim>
+      size_t createMortonCodeArray(Mesh* mesh, mvector<BuildPrim>& morton, BuildProgressMonitor& progressMonitor);
   }
 }
 
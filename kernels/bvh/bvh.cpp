@@ -16,6 +16,18 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "bvh_collider.h"
+#include "../common/serialize.h"
+#include "../common/scene.h"
+#include "../common/accelinstance.h"
+#include "../../common/sys/regression.h"
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglev_mb.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
+#include "../geometry/object.h"
 
 namespace embree
 {
@@ -23,7 +35,7 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0), restructureSAH(0.0f)
   {
   }
 
@@ -41,12 +53,252 @@ namespace embree
     alloc.clear();
   }
 
+  namespace
+  {
+    /*! maps addresses of a saved BVH to the addresses of the loaded memory blocks */
+    struct BlockRelocation
+    {
+      struct Range
+      {
+        Range (size_t begin, size_t end)
+          : begin(begin), end(end), dst(0) {}
+
+        __forceinline bool operator< (const Range& other) const {
+          return begin < other.begin;
+        }
+
+        size_t begin;
+        size_t end;
+        size_t dst;
+      };
+
+      size_t operator() (size_t ptr) const
+      {
+        auto i = std::upper_bound(ranges.begin(),ranges.end(),Range(ptr,ptr));
+        if (i == ranges.begin() || ptr >= (--i)->end)
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid node reference in file");
+        return i->dst + (ptr - i->begin);
+      }
+
+    public:
+      std::vector<Range> ranges;
+    };
+
+    template<int N>
+    void relocateNodes(typename BVHN<N>::NodeRef& node, const BlockRelocation& relocation)
+    {
+      const size_t ptr = (size_t)node & ~BVHN<N>::align_mask;
+      if (ptr == 0) return;
+      node = relocation(ptr) | ((size_t)node & BVHN<N>::align_mask);
+      if (node.isLeaf()) return;
+
+      typename BVHN<N>::BaseNode* n = node.baseNode(BVH_FLAG_ALIGNED_NODE);
+      for (size_t c=0; c<N; c++)
+        relocateNodes<N>(n->child(c),relocation);
+    }
+  }
+
+  template<int N>
+  void BVHN<N>::save(std::ostream& stream)
+  {
+    /* leaves of these primitive types reference memory outside of the allocator */
+    const std::string name = primTy->name();
+    if (objects.size() || subdiv_patches.size() || name == "instance" || name == "subdivpatch1")
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"saving of BVH" + toString(N) + "<" + name + "> not supported");
+
+    std::vector<std::pair<const char*,size_t>> blocks;
+    alloc.forEachUsedBlock([&] (const char* ptr, size_t bytes) {
+        if (bytes) blocks.push_back(std::make_pair(ptr,bytes));
+      });
+
+    writeBinary(stream,int(N));
+    writeString(stream,name);
+    writeBinary(stream,bounds);
+    writeBinary(stream,numPrimitives);
+    writeBinary(stream,numVertices);
+    writeBinary(stream,(size_t)root);
+    writeBinary(stream,blocks.size());
+    for (auto& block : blocks) {
+      writeBinary(stream,(size_t)block.first);
+      writeBinary(stream,block.second);
+    }
+    for (auto& block : blocks)
+      writeBytes(stream,block.first,block.second);
+  }
+
+  namespace
+  {
+    template<typename Primitive>
+    size_t leafPrimitiveIDs(const char* ptr, size_t num, unsigned int* geomIDs, unsigned int* primIDs)
+    {
+      size_t n = 0;
+      const Primitive* prims = (const Primitive*) ptr;
+      for (size_t i=0; i<num; i++)
+        for (size_t j=0; j<prims[i].size(); j++, n++) {
+          geomIDs[n] = prims[i].geomID(j);
+          primIDs[n] = prims[i].primID(j);
+        }
+      return n;
+    }
+
+    template<>
+    size_t leafPrimitiveIDs<Object>(const char* ptr, size_t num, unsigned int* geomIDs, unsigned int* primIDs)
+    {
+      const Object* prims = (const Object*) ptr;
+      for (size_t i=0; i<num; i++) {
+        geomIDs[i] = prims[i].geomID();
+        primIDs[i] = prims[i].primID();
+      }
+      return num;
+    }
+  }
+
+  template<int N>
+  typename BVHN<N>::LeafPrimitiveIDsFunc BVHN<N>::getLeafPrimitiveIDsFunc() const
+  {
+    if      (primTy == &Triangle4::type   ) return leafPrimitiveIDs<Triangle4>;
+    else if (primTy == &Triangle4v::type  ) return leafPrimitiveIDs<Triangle4v>;
+    else if (primTy == &Triangle4i::type  ) return leafPrimitiveIDs<Triangle4i>;
+    else if (primTy == &Triangle4vMB::type) return leafPrimitiveIDs<Triangle4vMB>;
+    else if (primTy == &Quad4v::type      ) return leafPrimitiveIDs<Quad4v>;
+    else if (primTy == &Quad4i::type      ) return leafPrimitiveIDs<Quad4i>;
+    else if (primTy == &Object::type      ) return leafPrimitiveIDs<Object>;
+    else return nullptr;
+  }
+
+  template<int N>
+  bool BVHN<N>::pointQuery(RTCPointQuery* query, PointQueryContext* context)
+  {
+    LeafPrimitiveIDsFunc leaf = getLeafPrimitiveIDsFunc();
+
+    /* curves, subdivision surfaces, grids, and instances are not supported */
+    if (leaf == nullptr || root == emptyNode)
+      return false;
+
+    struct StackItem { NodeRef ref; float dist; };
+    StackItem stack[1+(N-1)*maxDepth];
+    StackItem* sptr = stack;
+    *sptr++ = { root, 0.0f };
+
+    const float time = query->time;
+    bool changed = false;
+
+    while (sptr != stack)
+    {
+      const StackItem cur = *--sptr;
+      if (cur.dist > sqr(query->radius)) continue;
+      NodeRef node = cur.ref;
+
+      if (node.isLeaf())
+      {
+        unsigned int geomIDs[maxLeafPrimitives], primIDs[maxLeafPrimitives];
+        size_t num; const char* prim = node.leaf(num);
+        num = leaf(prim,num,geomIDs,primIDs);
+        for (size_t i=0; i<num; i++)
+          changed |= context->invoke(query,geomIDs[i],primIDs[i]);
+        continue;
+      }
+
+      /* compute distances to all children that overlap the query sphere */
+      StackItem items[N]; size_t numItems = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        BBox3fa bounds;
+        if (node.isAlignedNode()) {
+          if (node.alignedNode()->child(i) == emptyNode) break;
+          bounds = node.alignedNode()->bounds(i);
+        }
+        else if (node.isAlignedNodeMB()) {
+          if (node.alignedNodeMB()->child(i) == emptyNode) break;
+          bounds = node.alignedNodeMB()->bounds(i,time);
+        }
+        else if (node.isAlignedNodeMB4D()) {
+          const AlignedNodeMB4D* n = node.alignedNodeMB4D();
+          if (n->child(i) == emptyNode) break;
+          if (time < n->lower_t[i] || time >= n->upper_t[i]) continue;
+          bounds = n->bounds(i,time);
+        }
+        else if (node.isQuantizedNode()) {
+          if (node.quantizedNode()->child(i) == emptyNode) break;
+          bounds = node.quantizedNode()->bounds(i);
+        }
+        else
+          break;
+
+        const float dist = sqrDistance(query,bounds);
+        if (dist > sqr(query->radius)) continue;
+
+        /* keep children sorted by decreasing distance such that the closest one gets popped first */
+        size_t j = numItems++;
+        for (; j>0 && items[j-1].dist < dist; j--) items[j] = items[j-1];
+        items[j] = { node.baseNode(BVH_FLAG_ALIGNED_NODE)->child(i), dist };
+      }
+      for (size_t i=0; i<numItems; i++)
+        *sptr++ = items[i];
+    }
+    return changed;
+  }
+
+  template<int N>
+  void BVHN<N>::collide(AccelData* other, CollideContext* context)
+  {
+    if (other->type == AccelData::TY_BVH4)
+      BVHNCollider<N,4>::collide(this,(BVHN<4>*)other,context);
+#if defined(__AVX__)
+    else if (N == 8 && other->type == AccelData::TY_BVH8)
+      BVHNCollider<8,8>::collide((BVHN<8>*)this,(BVHN<8>*)other,context);
+#endif
+    else if (other->type == AccelData::TY_BVH8)
+    {
+      /* the BVH8 drives the traversal as BVH8 code is only compiled for AVX */
+      CollideContext swapped = context->swap();
+      other->collide(this,&swapped);
+    }
+  }
+
+  template<int N>
+  void BVHN<N>::load(std::istream& stream)
+  {
+    if (readBinary<int>(stream) != N)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH branching factor does not match");
+    const std::string name = readString(stream);
+    if (name != primTy->name())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH primitive type " + name + " does not match " + primTy->name());
+
+    const LBBox3fa bounds = readBinary<LBBox3fa>(stream);
+    const size_t numPrimitives = readBinary<size_t>(stream);
+    const size_t numVertices = readBinary<size_t>(stream);
+    NodeRef root = readBinary<size_t>(stream);
+
+    BlockRelocation relocation;
+    const size_t numBlocks = readBinary<size_t>(stream);
+    for (size_t i=0; i<numBlocks; i++) {
+      const size_t begin = readBinary<size_t>(stream);
+      const size_t bytes = readBinary<size_t>(stream);
+      relocation.ranges.push_back(BlockRelocation::Range(begin,begin+bytes));
+    }
+
+    /* copy all blocks into freshly allocated memory and fix up the node references */
+    clear();
+    for (auto& range : relocation.ranges) {
+      char* ptr = (char*) alloc.mallocBlock(range.end-range.begin);
+      readBytes(stream,ptr,range.end-range.begin);
+      range.dst = (size_t) ptr;
+    }
+    std::sort(relocation.ranges.begin(),relocation.ranges.end());
+    relocateNodes<N>(root,relocation);
+
+    set(root,bounds,numPrimitives);
+    this->numVertices = numVertices;
+  }
+
   template<int N>
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
     this->root = root;
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
+    this->restructureSAH = 0.0f;
   }	
 
   template<int N>
@@ -122,6 +374,132 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  void BVHN<N>::layoutNodes(size_t numPrimitives)
+  {
+    if (numPrimitives >= device->node_clustering_threshold)
+      layoutClusteredNodes();
+    else
+      layoutLargeNodes(size_t(numPrimitives*0.005f));
+  }
+
+  template<int N>
+  void BVHN<N>::gatherAlignedNodes(NodeRef node, std::vector<AlignedNode*>& nodes)
+  {
+    if (!node.isAlignedNode())
+      return;
+
+    nodes.push_back(node.alignedNode());
+    for (size_t c=0; c<N; c++)
+      gatherAlignedNodes(node.alignedNode()->child(c),nodes);
+  }
+
+  template<int N>
+  void BVHN<N>::layoutClusteredNodes()
+  {
+    /* the memory of the existing nodes gets reused in address order */
+    std::vector<AlignedNode*> nodes;
+    gatherAlignedNodes(root,nodes);
+    const size_t numNodes = nodes.size();
+    if (numNodes == 0)
+      return;
+    std::vector<AlignedNode*> slots(nodes);
+    std::sort(slots.begin(),slots.end());
+    auto slot = [&] (AlignedNode* node) -> size_t {
+      return std::lower_bound(slots.begin(),slots.end(),node)-slots.begin();
+    };
+
+    /* count the nodes of each subtree, children follow their parent in depth first order */
+    std::vector<size_t> subtreeSize(numNodes);
+    for (ssize_t i=numNodes-1; i>=0; i--)
+    {
+      size_t size = 1;
+      for (size_t c=0; c<N; c++)
+        if (nodes[i]->child(c).isAlignedNode())
+          size += subtreeSize[slot(nodes[i]->child(c).alignedNode())];
+      subtreeSize[slot(nodes[i])] = size;
+    }
+
+    /* clusters fill the remaining slots of a page and get ordered depth first */
+    std::vector<AlignedNode*> order;
+    std::vector<AlignedNode*> clusters;
+    std::vector<AlignedNode*> candidates;
+    order.reserve(numNodes);
+    clusters.push_back(root.alignedNode());
+
+    while (!clusters.empty())
+    {
+      AlignedNode* cluster = clusters.back(); clusters.pop_back();
+      const size_t numClusters = clusters.size();
+      const size_t begin = order.size();
+      size_t end = begin+1;
+      while (end < numNodes && size_t(slots[end])/PAGE_SIZE == size_t(slots[begin])/PAGE_SIZE) end++;
+      candidates.clear();
+      candidates.push_back(cluster);
+
+      /* add the largest subtree that fits completely, otherwise open the largest subtree if its children likely fit too */
+      while (!candidates.empty() && order.size() < end)
+      {
+        const size_t room = end-order.size();
+        size_t best = 0;
+        bool fits = false;
+        for (size_t i=0; i<candidates.size(); i++)
+        {
+          const size_t size = subtreeSize[slot(candidates[i])];
+          const size_t bestSize = subtreeSize[slot(candidates[best])];
+          if (size <= room && (!fits || size > bestSize)) { best = i; fits = true; }
+          else if (!fits && size > bestSize) best = i;
+        }
+        if (!fits && room <= N && order.size() > begin)
+          break;
+
+        AlignedNode* node = candidates[best];
+        candidates[best] = candidates.back();
+        candidates.pop_back();
+        if (fits) {
+          gatherAlignedNodes(encodeNode(node),order);
+          continue;
+        }
+
+        order.push_back(node);
+        for (size_t c=0; c<N; c++)
+          if (node->child(c).isAlignedNode())
+            candidates.push_back(node->child(c).alignedNode());
+      }
+
+      /* the remaining subtrees start new clusters */
+      clusters.insert(clusters.end(),candidates.begin(),candidates.end());
+      std::reverse(clusters.begin()+numClusters,clusters.end());
+    }
+    assert(order.size() == numNodes);
+
+    /* the ith node in cluster order moves into the ith slot */
+    std::vector<size_t> dest(numNodes);
+    for (size_t i=0; i<numNodes; i++)
+      dest[slot(order[i])] = i;
+
+    /* update all node references before the nodes get moved */
+    root = encodeNode(slots[dest[slot(root.alignedNode())]]);
+    for (size_t i=0; i<numNodes; i++)
+      for (size_t c=0; c<N; c++)
+        if (order[i]->child(c).isAlignedNode())
+          order[i]->child(c) = encodeNode(slots[dest[slot(order[i]->child(c).alignedNode())]]);
+
+    /* move the nodes in place by following the cycles of the permutation */
+    for (size_t i=0; i<numNodes; i++)
+    {
+      if (dest[i] == i) continue;
+      AlignedNode node = *slots[i];
+      size_t j = i;
+      do {
+        const size_t k = dest[j];
+        dest[j] = j;
+        std::swap(node,*slots[k]);
+        j = k;
+      } while (j != i);
+    }
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
@@ -198,6 +576,88 @@ namespace embree
 
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
   template class BVHN<4>;
+
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+  struct bvh_clustered_layout_regression_test : public RegressionTest
+  {
+    bvh_clustered_layout_regression_test()
+      : RegressionTest("bvh_clustered_layout_regression_test")
+    {
+      registerRegressionTest(this);
+    }
+
+    /* counts the links between aligned nodes that cross a page boundary */
+    static void countPageCrossings(BVH4::NodeRef ref, size_t& numLinks, size_t& numCrossings)
+    {
+      if (!ref.isAlignedNode()) return;
+      BVH4::AlignedNode* node = ref.alignedNode();
+      for (size_t c=0; c<4; c++)
+      {
+        if (!node->child(c).isAlignedNode()) continue;
+        numLinks++;
+        numCrossings += size_t(node)/PAGE_SIZE != size_t(node->child(c).alignedNode())/PAGE_SIZE;
+        countPageCrossings(node->child(c),numLinks,numCrossings);
+      }
+    }
+
+    bool run ()
+    {
+      /* small triangles spread over some region */
+      const size_t numTriangles = 100000;
+      std::vector<Vec3f> vertices(3*numTriangles);
+      std::vector<unsigned int> indices(3*numTriangles);
+      for (size_t i=0; i<3*numTriangles; i++) {
+        const float x = float(i/3*7%1000), y = float(i/3*13%997), z = float(i/3*29%991);
+        vertices[i] = Vec3f(x,y,z) + Vec3f(float(i%3 == 1),float(i%3 == 2),0.0f);
+        indices[i] = unsigned(i);
+      }
+
+      /* build the same BVH without and with clustered node layout */
+      const char* cfgs[2] = { "tri_accel=bvh4.triangle4",
+                              "tri_accel=bvh4.triangle4,node_clustering_threshold=0" };
+      size_t usedBytes[2], statBytes[2], numLinks[2], numCrossings[2];
+      double sah[2];
+      for (size_t i=0; i<2; i++)
+      {
+        /* rtcNewDevice cannot get used while the regression test runs inside rtcGetDeviceProperty */
+        Ref<Device> device = new Device(cfgs[i]);
+        RTCScene hscene = rtcNewScene((RTCDevice)device.ptr);
+        RTCGeometry geom = rtcNewGeometry((RTCDevice)device.ptr,RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,vertices.data(),0,sizeof(Vec3f),vertices.size());
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,indices.data(),0,3*sizeof(unsigned int),numTriangles);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometry(hscene,geom);
+        rtcReleaseGeometry(geom);
+        rtcCommitScene(hscene);
+
+        Scene* scene = (Scene*) hscene;
+        BVH4* bvh = (BVH4*) ((AccelInstance*)scene->accels[0])->getAccel();
+        BVH4Statistics stat(bvh);
+        usedBytes[i] = bvh->alloc.getUsedBytes();
+        statBytes[i] = stat.bytesUsed();
+        sah[i] = stat.sah();
+        numLinks[i] = numCrossings[i] = 0;
+        countPageCrossings(bvh->root,numLinks[i],numCrossings[i]);
+
+        rtcReleaseScene(hscene);
+      }
+
+      /* the clustered layout keeps the topology and needs no additional memory */
+      bool passed = true;
+      passed &= statBytes[0] == statBytes[1];
+      passed &= sah[0] == sah[1];
+      passed &= numLinks[0] == numLinks[1];
+      passed &= usedBytes[1] <= usedBytes[0];
+
+      /* most links between nodes stay inside a page */
+      passed &= numCrossings[1] < numCrossings[0];
+      passed &= 4*numCrossings[1] < numLinks[1];
+      return passed;
+    }
+  };
+
+  bvh_clustered_layout_regression_test bvh_clustered_layout_regression;
+#endif
 #endif
 }
 
@@ -133,6 +133,7 @@ namespace embree
 
     /*! Maximum number of primitive blocks in a leaf. */
     static const size_t maxLeafBlocks = items_mask-tyLeaf;
+    static const size_t maxLeafPrimitives = 4*maxLeafBlocks; // primitive blocks store at most 4 primitives
 
   public:
 
@@ -1429,6 +1430,24 @@ namespace embree
     /*! clears the acceleration structure */
     void clear();
 
+    /*! writes the BVH nodes and primitive blocks to a binary stream */
+    void save(std::ostream& stream);
+
+    /*! restores the BVH nodes and primitive blocks written by save */
+    void load(std::istream& stream);
+
+    /*! invokes the point query callback for all primitives whose bounds overlap the query sphere */
+    bool pointQuery(RTCPointQuery* query, PointQueryContext* context);
+
+    /*! reports all pairs of primitives of this and some other BVH whose bounds overlap */
+    void collide(AccelData* other, CollideContext* context);
+
+    /*! function that stores the geometry and primitive IDs of all primitives of a leaf and returns their number */
+    typedef size_t (*LeafPrimitiveIDsFunc)(const char* prims, size_t num, unsigned int* geomIDs, unsigned int* primIDs);
+
+    /*! returns the function to decode leaves of this BVH, or nullptr if the primitive type is not supported */
+    LeafPrimitiveIDsFunc getLeafPrimitiveIDsFunc() const;
+
     /*! sets BVH members after build */
     void set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives);
 
@@ -1439,6 +1458,13 @@ namespace embree
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
 
+    /*! lays out the nodes of a BVH built over numPrimitives primitives after build */
+    void layoutNodes(size_t numPrimitives);
+
+    /*! reorders all aligned nodes in place, such that the nodes of a page form subtrees */
+    void layoutClusteredNodes();
+    static void gatherAlignedNodes(NodeRef node, std::vector<AlignedNode*>& nodes);
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
 
@@ -1533,6 +1559,7 @@ namespace embree
   public:
     size_t numPrimitives;              //!< number of primitives the BVH is build over
     size_t numVertices;                //!< number of vertices the BVH references
+    float restructureSAH;              //!< unnormalized SAH cost reduction of treelet restructuring
 
     /*! data arrays for special builders */
   public:
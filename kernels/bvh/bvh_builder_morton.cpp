@@ -87,17 +87,17 @@ namespace embree
       }
     };
 
-    template<int N, typename Primitive>
+    template<int N, typename Primitive, typename BuildPrim>
     struct CreateMortonLeaf;
 
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4>
+    template<int N, typename BuildPrim>
+    struct CreateMortonLeaf<N,Triangle4,BuildPrim>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::NodeRecord NodeRecord;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BVHBuilderMorton::BuildPrim* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BuildPrim* morton)
         : mesh(mesh), morton(morton) {}
 
       __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
@@ -143,17 +143,17 @@ namespace embree
     
     private:
       TriangleMesh* mesh;
-      BVHBuilderMorton::BuildPrim* morton;
+      BuildPrim* morton;
     };
     
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4v>
+    template<int N, typename BuildPrim>
+    struct CreateMortonLeaf<N,Triangle4v,BuildPrim>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::NodeRecord NodeRecord;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BVHBuilderMorton::BuildPrim* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BuildPrim* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
@@ -197,17 +197,17 @@ namespace embree
       }
     private:
       TriangleMesh* mesh;
-      BVHBuilderMorton::BuildPrim* morton;
+      BuildPrim* morton;
     };
 
-    template<int N>
-    struct CreateMortonLeaf<N,Triangle4i>
+    template<int N, typename BuildPrim>
+    struct CreateMortonLeaf<N,Triangle4i,BuildPrim>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::NodeRecord NodeRecord;
 
-      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BVHBuilderMorton::BuildPrim* morton)
+      __forceinline CreateMortonLeaf (TriangleMesh* mesh, BuildPrim* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
@@ -263,17 +263,17 @@ namespace embree
       }
     private:
       TriangleMesh* mesh;
-      BVHBuilderMorton::BuildPrim* morton;
+      BuildPrim* morton;
     };
 
-    template<int N>
-    struct CreateMortonLeaf<N,Quad4v>
+    template<int N, typename BuildPrim>
+    struct CreateMortonLeaf<N,Quad4v,BuildPrim>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::NodeRecord NodeRecord;
 
-      __forceinline CreateMortonLeaf (QuadMesh* mesh, BVHBuilderMorton::BuildPrim* morton)
+      __forceinline CreateMortonLeaf (QuadMesh* mesh, BuildPrim* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
@@ -320,17 +320,17 @@ namespace embree
       }
     private:
       QuadMesh* mesh;
-      BVHBuilderMorton::BuildPrim* morton;
+      BuildPrim* morton;
     };
 
-    template<int N>
-    struct CreateMortonLeaf<N,Object>
+    template<int N, typename BuildPrim>
+    struct CreateMortonLeaf<N,Object,BuildPrim>
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::NodeRecord NodeRecord;
 
-      __forceinline CreateMortonLeaf (UserGeometry* mesh, BVHBuilderMorton::BuildPrim* morton)
+      __forceinline CreateMortonLeaf (UserGeometry* mesh, BuildPrim* morton)
         : mesh(mesh), morton(morton) {}
       
       __noinline NodeRecord operator() (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc)
@@ -364,7 +364,7 @@ namespace embree
       }
     private:
       UserGeometry* mesh;
-      BVHBuilderMorton::BuildPrim* morton;
+      BuildPrim* morton;
     };
 
     template<typename Mesh>
@@ -373,7 +373,8 @@ namespace embree
       __forceinline CalculateMeshBounds (Mesh* mesh)
         : mesh(mesh) {}
       
-      __forceinline const BBox3fa operator() (const BVHBuilderMorton::BuildPrim& morton) {
+      template<typename BuildPrim>
+      __forceinline const BBox3fa operator() (const BuildPrim& morton) {
         return mesh->bounds(morton.index);
       }
       
@@ -392,7 +393,7 @@ namespace embree
     public:
       
       BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, const size_t minLeafSize, const size_t maxLeafSize, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD)
-        : bvh(bvh), mesh(mesh), morton(bvh->device,0), settings(N,BVH::maxBuildDepth,minLeafSize,maxLeafSize,singleThreadThreshold) {}
+        : bvh(bvh), mesh(mesh), morton(bvh->device,0), morton64(bvh->device,0), settings(N,BVH::maxBuildDepth,minLeafSize,maxLeafSize,singleThreadThreshold) {}
       
       /* build function */
       void build() 
@@ -400,7 +401,7 @@ namespace embree
         /* we reset the allocator when the mesh size changed */
         if (mesh->numPrimitivesChanged) {
           bvh->alloc.clear();
-          morton.clear();
+          clear();
         }
         size_t numPrimitives = mesh->size();
         
@@ -409,21 +410,34 @@ namespace embree
           bvh->set(BVH::emptyNode,empty,0);
           return;
         }
-        
+
+        /* large meshes use 64 bit morton codes as 10 bits per dimension get too coarse */
+        if (numPrimitives >= bvh->device->morton_code64_threshold) {
+          morton.clear();
+          build(morton64,numPrimitives);
+        } else {
+          morton64.clear();
+          build(morton,numPrimitives);
+        }
+      }
+
+      template<typename BuildPrim>
+      void build(mvector<BuildPrim>& morton, size_t numPrimitives)
+      {
         /* preallocate arrays */
         morton.resize(numPrimitives);
         size_t bytesEstimated = numPrimitives*sizeof(AlignedNode)/(4*N) + size_t(1.2f*Primitive::blocks(numPrimitives)*sizeof(Primitive));
-        size_t bytesMortonCodes = numPrimitives*sizeof(BVHBuilderMorton::BuildPrim);
+        size_t bytesMortonCodes = numPrimitives*sizeof(BuildPrim);
         bytesEstimated = max(bytesEstimated,bytesMortonCodes); // the first allocation block is reused to sort the morton codes
         bvh->alloc.init(bytesMortonCodes,bytesMortonCodes,bytesEstimated);
 
         /* create morton code array */
-        BVHBuilderMorton::BuildPrim* dest = (BVHBuilderMorton::BuildPrim*) bvh->alloc.specialAlloc(bytesMortonCodes);
+        BuildPrim* dest = (BuildPrim*) bvh->alloc.specialAlloc(bytesMortonCodes);
         size_t numPrimitivesGen = createMortonCodeArray<Mesh>(mesh,morton,bvh->scene->progressInterface);
 
         /* create BVH */
         SetBVHNBounds<N> setBounds(bvh);
-        CreateMortonLeaf<N,Primitive> createLeaf(mesh,morton.data());
+        CreateMortonLeaf<N,Primitive,BuildPrim> createLeaf(mesh,morton.data());
         CalculateMeshBounds<Mesh> calculateBounds(mesh);
         auto root = BVHBuilderMorton::build<NodeRecord>(
           typename BVH::CreateAlloc(bvh), 
@@ -453,12 +467,14 @@ namespace embree
       
       void clear() {
         morton.clear();
+        morton64.clear();
       }
       
     private:
       BVH* bvh;
       Mesh* mesh;
       mvector<BVHBuilderMorton::BuildPrim> morton;
+      mvector<BVHBuilderMorton::BuildPrim64> morton64;
       BVHBuilderMorton::Settings settings;
     };
 
@@ -16,6 +16,7 @@
 
 #include "bvh.h"
 #include "bvh_builder.h"
+#include "bvh_restructure.h"
 
 #include "../builders/primrefgen.h"
 #include "../builders/splitter.h"
@@ -133,7 +134,12 @@ namespace embree
           pinfo,settings);
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
-        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+
+        /* optimize topology of high quality BVHs */
+        if ((mesh ? RTCBuildQuality(mesh->quality) : scene->quality_flags) == RTC_BUILD_QUALITY_HIGH)
+          BVHNRestructure<N>::restructure(bvh,bvh->device->restructure_passes);
+
+        bvh->layoutNodes(pinfo.size());
 
 	/* clear temporary data for static geometry */
 	if (scene && scene->isStaticAccel()) {
@@ -180,7 +180,7 @@ namespace embree
 
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeaf,virtualprogress,prims.data(),pinfo,settings);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
-        bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+        bvh->layoutNodes(pinfo.size());
         
 	/* clear temporary data for static geometry */
 	if (scene->isStaticAccel()) {
@@ -36,7 +36,8 @@ namespace embree
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel, const size_t singleThreadThreshold)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold),
+        topLevelValid(false), topLevelArea(0.0f), topLevelSAH(0.0f), topLevelNodes(0), topLevelDeadNodes(0) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel () {
@@ -59,20 +60,23 @@ namespace embree
             }
           });
       }
+
+      /* the top level BVH still references deleted objects */
+      if (num < topLevelObjects.size())
+        topLevelValid = false;
       
 #if PROFILE
       while(1) 
 #endif
       {
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives<Mesh,false>();
 
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
+        topLevelValid = false;
         return;
       }
 
@@ -141,6 +145,32 @@ namespace embree
         }
       });
 
+      /* incrementally update the top level BVH if only few objects changed */
+      if (topLevelValid)
+      {
+        if (topLevelObjects.size() < num) topLevelObjects.resize(num);
+
+        std::vector<unsigned int> modified;
+        for (size_t objectID=0; objectID<num; objectID++)
+        {
+          Mesh* mesh = scene->getSafe<Mesh>(objectID);
+          const bool valid = mesh && mesh->isEnabled() && mesh->numTimeSteps == 1 && !objects[objectID]->getBounds().empty();
+          const NodeRef root = valid ? objects[objectID]->root : NodeRef(BVH::emptyNode);
+          const TopLevelObject& object = topLevelObjects[objectID];
+          if (object.deleted || object.root != root || (valid && mesh->isModified()))
+            modified.push_back((unsigned int)objectID);
+        }
+
+        if (updateTopLevel(modified,numPrimitives)) {
+          bvh->alloc.cleanup();
+          bvh->postBuild(t0);
+          return;
+        }
+      }
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+      topLevelValid = false;
 
 #if PROFILE
       double d0 = getSeconds();
@@ -221,6 +251,11 @@ namespace embree
       
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs.resize(extSize); 
+
+            /* record top level leaves for incremental updates */
+            const bool recordLeaves = scene->device->toplevel_update_ratio > 0.0f;
+            std::vector<std::pair<NodeRef,unsigned int>> leaves(recordLeaves ? extSize : 0);
+            std::atomic<size_t> numLeaves(0);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -229,6 +264,7 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
+                if (recordLeaves) leaves[numLeaves++] = std::make_pair(refs[range.begin()].node,refs[range.begin()].geomID());
                 return (NodeRef) refs[range.begin()].node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
@@ -252,6 +288,13 @@ namespace embree
 
             
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER
+            if (recordLeaves) {
+              leaves.resize(numLeaves);
+              initTopLevelUpdate(leaves);
+            }
+#endif
           }
         }
 #if defined(TASKING_TBB) && defined(__AVX512ER__) && USE_TASK_ARENA // KNL
@@ -270,9 +313,182 @@ namespace embree
 
     }
     
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::initTopLevelUpdate(const std::vector<std::pair<NodeRef,unsigned int>>& leaves)
+    {
+      topLevelRefs.clear();
+      topLevelObjects.clear();
+      topLevelObjects.resize(scene->size());
+      topLevelArea = 0.0f;
+      topLevelNodes = 0;
+      topLevelDeadNodes = 0;
+
+      for (auto& leaf : leaves) 
+      {
+        const unsigned int objectID = leaf.second;
+        topLevelRefs[leaf.first] = TopLevelRef(BVH::emptyNode,0,objectID);
+        topLevelObjects[objectID].root = objects[objectID]->root;
+        topLevelObjects[objectID].refs.push_back(leaf.first);
+      }
+
+      if (!bvh->root.isAlignedNode())
+        return;
+
+      linkTopLevelRecursive(bvh->root,BVH::emptyNode,0);
+      topLevelSAH = topLevelArea/area(bvh->bounds.bounds());
+      topLevelValid = true;
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::linkTopLevelRecursive(NodeRef ref, NodeRef parent, unsigned int slot)
+    {
+      /* leaves and unmodified branches only get linked to their new parent */
+      auto i = topLevelRefs.find(ref);
+      if (i != topLevelRefs.end()) {
+        i->second.parent = parent;
+        i->second.slot = slot;
+        return;
+      }
+
+      topLevelRefs[ref] = TopLevelRef(parent,slot,-1);
+      AlignedNode* node = ref.alignedNode();
+      topLevelArea += area(node->bounds());
+      topLevelNodes++;
+
+      for (unsigned int c=0; c<N; c++)
+        if (node->child(c) != BVH::emptyNode)
+          linkTopLevelRecursive(node->child(c),ref,c);
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::removeTopLevelRecursive(NodeRef ref, size_t& numPrims)
+    {
+      AlignedNode* node = ref.alignedNode();
+      topLevelArea -= area(node->bounds());
+      topLevelNodes--;
+      topLevelDeadNodes++;
+      topLevelRefs.erase(ref);
+
+      for (size_t c=0; c<N; c++)
+      {
+        const NodeRef child = node->child(c);
+        if (child == BVH::emptyNode) continue;
+
+        /* leaves of modified objects got already removed */
+        auto i = topLevelRefs.find(child);
+        if (i == topLevelRefs.end()) continue;
+
+        if (i->second.dirty) removeTopLevelRecursive(child,numPrims);
+        else prims[numPrims++] = PrimRef(node->bounds(c),(size_t)child);
+      }
+    }
+
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::updateTopLevel(const std::vector<unsigned int>& modified, const size_t numPrimitives)
+    {
+      if (modified.size() == 0) {
+        bvh->set(bvh->root,bvh->bounds,numPrimitives);
+        return true;
+      }
+
+      if (float(modified.size()) > scene->device->toplevel_update_ratio*float(topLevelObjects.size()))
+        return false;
+
+      /* mark all nodes on the paths from the leaves of modified objects to the root */
+      size_t numDirty = 1;
+      topLevelRefs[bvh->root].dirty = true;
+      for (unsigned int objectID : modified)
+      {
+        TopLevelObject& object = topLevelObjects[objectID];
+        for (NodeRef ref : object.refs)
+        {
+          NodeRef parent = topLevelRefs[ref].parent;
+          topLevelRefs.erase(ref);
+          
+          while (parent != BVH::emptyNode) 
+          {
+            TopLevelRef& node = topLevelRefs[parent];
+            if (node.dirty) break;
+            node.dirty = true;
+            numDirty++;
+            parent = node.parent;
+          }
+        }
+        object.root = BVH::emptyNode;
+        object.refs.clear();
+        object.deleted = false;
+      }
+
+      /* collect all unmodified branches hanging off the dirty nodes */
+      size_t numPrims = 0;
+      prims.resize(numDirty*N+modified.size());
+      removeTopLevelRecursive(bvh->root,numPrims);
+
+      /* re-insert modified objects */
+      for (unsigned int objectID : modified)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1)
+          continue;
+
+        BVH* object = objects[objectID];
+        if (object->getBounds().empty())
+          continue;
+
+        topLevelObjects[objectID].root = object->root;
+        topLevelObjects[objectID].refs.push_back(object->root);
+        topLevelRefs[object->root] = TopLevelRef(BVH::emptyNode,0,objectID);
+        prims[numPrims++] = PrimRef(object->getBounds(),(size_t)object->root);
+      }
+
+      /* small top level BVHs are handled by the full rebuild */
+      if (numPrims < 2)
+        return false;
+
+      PrimInfo pinfo(empty);
+      for (size_t i=0; i<numPrims; i++)
+        pinfo.add_center2(prims[i]);
+
+      /* rebuild the dirty part of the top level BVH */
+      GeneralBVHBuilder::Settings settings;
+      settings.branchingFactor = N;
+      settings.maxDepth = BVH::maxBuildDepthLeaf;
+      settings.logBlockSize = bsr(N);
+      settings.minLeafSize = 1;
+      settings.maxLeafSize = 1;
+      settings.travCost = 1.0f;
+      settings.intCost = 1.0f;
+      settings.singleThreadThreshold = singleThreadThreshold;
+
+      NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
+        typename BVH::CreateAlloc(bvh),
+        typename BVH::AlignedNode::Create2(),
+        typename BVH::AlignedNode::Set2(),
+        
+        [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef {
+          assert(range.size() == 1);
+          return (NodeRef) prims[range.begin()].ID();
+        },
+        [&] (size_t dn) { bvh->scene->progressMonitor(0); },
+        prims.data(),pinfo,settings);
+
+      bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+      linkTopLevelRecursive(root,BVH::emptyNode,0);
+
+      /* do a full rebuild if the SAH cost increased too much or too much memory got wasted */
+      const float sah = topLevelArea/area(pinfo.geomBounds);
+      if (sah > scene->device->toplevel_update_max_sah*topLevelSAH || topLevelDeadNodes > topLevelNodes)
+        return false;
+
+      return true;
+    }
+    
     template<int N, typename Mesh>
     void BVHNBuilderTwoLevel<N,Mesh>::deleteGeometry(size_t geomID)
     {
+      if (geomID < topLevelObjects.size())
+        topLevelObjects[geomID].deleted = true;
+
       if (geomID >= objects.size()) return;
       builders[geomID].clear();
       delete objects [geomID]; objects [geomID] = nullptr;
@@ -288,6 +504,9 @@ namespace embree
 	if (builders[i].builder) builders[i].builder->clear();
 
       refs.clear();
+      topLevelValid = false;
+      topLevelRefs.clear();
+      topLevelObjects.clear();
     }
 
     template<int N, typename Mesh>
@@ -20,6 +20,8 @@
 #include "../common/primref.h"
 #include "../builders/priminfo.h"
 
+#include <unordered_map>
+
 namespace embree
 {
   namespace isa
@@ -113,6 +115,16 @@ namespace embree
 
       void open_sequential(const size_t extSize);
 
+      /*! records the top level BVH after a full rebuild for later incremental updates */
+      void initTopLevelUpdate(const std::vector<std::pair<NodeRef,unsigned int>>& leaves);
+
+      /*! incrementally rebuilds the top level BVH branches of modified objects, returns false if a full rebuild is required */
+      bool updateTopLevel(const std::vector<unsigned int>& modified, const size_t numPrimitives);
+
+    private:
+      void linkTopLevelRecursive(NodeRef ref, NodeRef parent, unsigned int slot);
+      void removeTopLevelRecursive(NodeRef ref, size_t& numPrims);
+
     public:
       
       struct BuilderState
@@ -148,6 +160,41 @@ namespace embree
 
       typedef mvector<BuildRef> bvector;
 
+    public:
+
+      /*! location of a top level node or leaf inside the top level BVH */
+      struct TopLevelRef
+      {
+        __forceinline TopLevelRef () {}
+
+        __forceinline TopLevelRef (NodeRef parent, unsigned int slot, unsigned int geomID)
+          : parent(parent), slot(slot), geomID(geomID), dirty(false) {}
+
+        NodeRef parent;       //!< parent node, or empty node for the root
+        unsigned int slot;    //!< child slot inside the parent node
+        unsigned int geomID;  //!< object of a top level leaf, or -1 for inner nodes
+        bool dirty;           //!< set for inner nodes that get rebuilt
+      };
+
+      /*! per object state of the top level BVH */
+      struct TopLevelObject
+      {
+        __forceinline TopLevelObject ()
+          : root(BVH::emptyNode), deleted(false) {}
+
+        NodeRef root;               //!< object root inserted into the top level BVH
+        std::vector<NodeRef> refs;  //!< top level leaves referencing the object
+        bool deleted;               //!< object got deleted since the last top level build
+      };
+
+      bool topLevelValid;           //!< true if the top level BVH can get updated incrementally
+      std::unordered_map<size_t,TopLevelRef> topLevelRefs;
+      std::vector<TopLevelObject> topLevelObjects;
+      float topLevelArea;           //!< sum of the surface areas of all top level inner nodes
+      float topLevelSAH;            //!< relative SAH cost of the top level BVH after the last full rebuild
+      size_t topLevelNodes;         //!< number of top level inner nodes after the last full rebuild
+      size_t topLevelDeadNodes;     //!< number of top level inner nodes discarded by incremental updates
+
     };
   }
 }
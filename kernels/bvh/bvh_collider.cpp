@@ -0,0 +1,194 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh_collider.h"
+#include "../common/scene.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  namespace
+  {
+    /*! minimal number of subtree pairs to distribute over the threads */
+    static const size_t minParallelPairs = 256;
+
+    /*! returns the number of children of a node and their bounds, leaves are returned as their own single child */
+    template<int N>
+    size_t getChildren(const typename BVHN<N>::NodeRef& node, const BBox3fa& bounds, typename BVHN<N>::NodeRef* refs, BBox3fa* childBounds)
+    {
+      typedef BVHN<N> BVH;
+      if (node.isLeaf()) {
+        refs[0] = node; childBounds[0] = bounds;
+        return 1;
+      }
+
+      size_t num = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        const typename BVH::NodeRef child = node.baseNode(BVH_FLAG_ALIGNED_NODE)->child(i);
+        if (child == BVH::emptyNode) break;
+
+        /* motion blur nodes are tested with their bounds over the entire time range */
+        if      (node.isAlignedNode()     ) childBounds[num] = node.alignedNode()->bounds(i);
+        else if (node.isAlignedNodeMB()   ) childBounds[num] = node.alignedNodeMB()->bounds(i);
+        else if (node.isAlignedNodeMB4D() ) childBounds[num] = node.alignedNodeMB()->bounds(i);
+        else if (node.isQuantizedNode()   ) childBounds[num] = node.quantizedNode()->bounds(i);
+        else { assert(false); break; } // unaligned nodes are only used for curves, which rtcCollide rejects
+        refs[num++] = child;
+      }
+      return num;
+    }
+
+    template<typename Mesh>
+    __forceinline BBox3fa primitiveBounds(const Mesh* mesh, unsigned int primID)
+    {
+      BBox3fa bounds = empty;
+      for (size_t t=0; t<mesh->numTimeSteps; t++)
+        bounds.extend(mesh->bounds(primID,t));
+      return bounds;
+    }
+
+    /*! returns the bounds of a primitive over all its time steps */
+    BBox3fa primitiveBounds(const Scene* scene, unsigned int geomID, unsigned int primID)
+    {
+      const Geometry* geometry = scene->get(geomID);
+      switch (geometry->getType()) {
+      case Geometry::GTY_TRIANGLE_MESH: return primitiveBounds((const TriangleMesh*)geometry,primID);
+      case Geometry::GTY_QUAD_MESH    : return primitiveBounds((const QuadMesh*)    geometry,primID);
+      case Geometry::GTY_USER_GEOMETRY: return primitiveBounds((const AccelSet*)    geometry,primID);
+      default                         : assert(false); return empty;
+      }
+    }
+  }
+
+  template<int N0, int N1>
+  BVHNCollider<N0,N1>::BVHNCollider (BVH0* bvh0, BVH1* bvh1, const CollideContext* context)
+    : bvh0(bvh0), bvh1(bvh1), context(context),
+      leaf0(bvh0->getLeafPrimitiveIDsFunc()), leaf1(bvh1->getLeafPrimitiveIDsFunc()) {}
+
+  template<int N0, int N1>
+  size_t BVHNCollider<N0,N1>::split(const NodePair& pair, NodePair* pairs) const
+  {
+    NodeRef0 refs0[N0]; BBox3fa bounds0[N0];
+    NodeRef1 refs1[N1]; BBox3fa bounds1[N1];
+    size_t num0 = 1, num1 = 1;
+    refs0[0] = pair.ref0; bounds0[0] = pair.bounds0;
+    refs1[0] = pair.ref1; bounds1[0] = pair.bounds1;
+
+    /* open the node with larger surface area, or the only inner node */
+    const bool open0 = !pair.ref0.isLeaf() && (pair.ref1.isLeaf() || halfArea(pair.bounds0) >= halfArea(pair.bounds1));
+    if (open0) num0 = getChildren<N0>(pair.ref0,pair.bounds0,refs0,bounds0);
+    else       num1 = getChildren<N1>(pair.ref1,pair.bounds1,refs1,bounds1);
+
+    size_t num = 0;
+    for (size_t i=0; i<num0; i++)
+      for (size_t j=0; j<num1; j++)
+        if (!disjoint(bounds0[i],bounds1[j]))
+          pairs[num++] = { refs0[i], bounds0[i], refs1[j], bounds1[j] };
+    return num;
+  }
+
+  template<int N0, int N1>
+  void BVHNCollider<N0,N1>::collide_recurse(const NodePair& pair, CollisionBuffer& buffer) const
+  {
+    if (pair.ref0.isLeaf() && pair.ref1.isLeaf()) {
+      collide_leaves(pair,buffer);
+      return;
+    }
+
+    NodePair pairs[N0 > N1 ? N0 : N1];
+    const size_t num = split(pair,pairs);
+    for (size_t i=0; i<num; i++)
+      collide_recurse(pairs[i],buffer);
+  }
+
+  template<int N0, int N1>
+  void BVHNCollider<N0,N1>::collide_leaves(const NodePair& pair, CollisionBuffer& buffer) const
+  {
+    unsigned int geomIDs0[BVH0::maxLeafPrimitives], primIDs0[BVH0::maxLeafPrimitives];
+    unsigned int geomIDs1[BVH1::maxLeafPrimitives], primIDs1[BVH1::maxLeafPrimitives];
+    BBox3fa bounds1[BVH1::maxLeafPrimitives];
+
+    size_t num0; const char* prims0 = pair.ref0.leaf(num0);
+    size_t num1; const char* prims1 = pair.ref1.leaf(num1);
+    num0 = leaf0(prims0,num0,geomIDs0,primIDs0);
+    num1 = leaf1(prims1,num1,geomIDs1,primIDs1);
+
+    for (size_t j=0; j<num1; j++)
+      bounds1[j] = primitiveBounds(bvh1->scene,geomIDs1[j],primIDs1[j]);
+
+    for (size_t i=0; i<num0; i++)
+    {
+      const BBox3fa bounds0 = primitiveBounds(bvh0->scene,geomIDs0[i],primIDs0[i]);
+      if (disjoint(bounds0,pair.bounds1)) continue;
+
+      for (size_t j=0; j<num1; j++)
+        if (!disjoint(bounds0,bounds1[j]))
+          buffer.add(geomIDs0[i],primIDs0[i],geomIDs1[j],primIDs1[j]);
+    }
+  }
+
+  template<int N0, int N1>
+  void BVHNCollider<N0,N1>::collide(BVH0* bvh0, BVH1* bvh1, const CollideContext* context)
+  {
+    const BVHNCollider collider(bvh0,bvh1,context);
+
+    /* BVHs of unsupported geometry types are empty, as rtcCollide rejects such scenes */
+    if (!collider.leaf0 || !collider.leaf1) return;
+    if (bvh0->root == BVH0::emptyNode || bvh1->root == BVH1::emptyNode) return;
+
+    const BBox3fa bounds0 = bvh0->bounds.bounds();
+    const BBox3fa bounds1 = bvh1->bounds.bounds();
+    if (disjoint(bounds0,bounds1)) return;
+
+    /* split the top levels of both BVHs into enough subtree pairs to keep all threads busy */
+    std::vector<NodePair> pairs(1,NodePair{ bvh0->root, bounds0, bvh1->root, bounds1 });
+    while (pairs.size() < minParallelPairs)
+    {
+      std::vector<NodePair> next; bool opened = false;
+      for (const NodePair& pair : pairs)
+      {
+        if (pair.ref0.isLeaf() && pair.ref1.isLeaf()) {
+          next.push_back(pair);
+          continue;
+        }
+        NodePair children[N0 > N1 ? N0 : N1];
+        const size_t num = collider.split(pair,children);
+        next.insert(next.end(),children,children+num);
+        opened = true;
+      }
+      pairs.swap(next);
+      if (!opened) break;
+    }
+
+    parallel_for(size_t(0), pairs.size(), [&] (const range<size_t>& r)
+    {
+      CollisionBuffer buffer(context);
+      for (size_t i=r.begin(); i<r.end(); i++)
+        collider.collide_recurse(pairs[i],buffer);
+      buffer.flush();
+    });
+  }
+
+#if defined(__AVX__)
+  template class BVHNCollider<8,8>;
+  template class BVHNCollider<8,4>;
+#endif
+
+#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+  template class BVHNCollider<4,4>;
+#endif
+}
@@ -0,0 +1,64 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh.h"
+#include "../common/collide.h"
+
+namespace embree
+{
+  /*! finds overlapping primitive pairs by traversing two BVHs simultaneously */
+  template<int N0, int N1>
+  class BVHNCollider
+  {
+    typedef BVHN<N0> BVH0;
+    typedef BVHN<N1> BVH1;
+    typedef typename BVH0::NodeRef NodeRef0;
+    typedef typename BVH1::NodeRef NodeRef1;
+
+    /*! pair of overlapping subtrees */
+    struct NodePair
+    {
+      NodeRef0 ref0; BBox3fa bounds0;
+      NodeRef1 ref1; BBox3fa bounds1;
+    };
+
+  public:
+
+    /*! reports all pairs of primitives of both BVHs whose bounds overlap */
+    static void collide(BVH0* bvh0, BVH1* bvh1, const CollideContext* context);
+
+  private:
+    BVHNCollider (BVH0* bvh0, BVH1* bvh1, const CollideContext* context);
+
+    /*! opens the larger node of a pair and returns the overlapping child pairs */
+    size_t split(const NodePair& pair, NodePair* pairs) const;
+
+    /*! recursively traverses both subtrees of a pair */
+    void collide_recurse(const NodePair& pair, CollisionBuffer& buffer) const;
+
+    /*! tests all primitives of two leaves for overlap */
+    void collide_leaves(const NodePair& pair, CollisionBuffer& buffer) const;
+
+  private:
+    BVH0* bvh0;
+    BVH1* bvh1;
+    const CollideContext* context;
+    typename BVH0::LeafPrimitiveIDsFunc leaf0;
+    typename BVH1::LeafPrimitiveIDsFunc leaf1;
+  };
+}
@@ -71,6 +71,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, Nx, types> nodeTraverser;
 
+      /* traversal statistics, only gathered if enabled in the context */
+      RTCTraversalStatistics* const stats = context->statistics();
+
       /* pop loop */
       while (true) pop:
       {
@@ -97,6 +100,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          if (unlikely(stats)) stats->nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -110,6 +114,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        if (unlikely(stats)) { stats->leaves++; stats->primitives += (unsigned int)num; }
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
@@ -158,6 +163,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, Nx, types> nodeTraverser;
 
+      /* traversal statistics, only gathered if enabled in the context */
+      RTCTraversalStatistics* const stats = context->statistics();
+
       /* pop loop */
       while (true) pop:
       {
@@ -174,6 +182,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          if (unlikely(stats)) stats->nodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -187,6 +196,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        if (unlikely(stats)) { stats->leaves++; stats->primitives += (unsigned int)num; }
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
@@ -66,6 +66,9 @@ namespace embree
       /* load the ray into SIMD registers */
       TravRay<N,Nx,robust> tray1(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+      /* traversal statistics, only gathered if enabled in the context */
+      RTCTraversalStatistics* const stats = context->statistics();
+
       /* pop loop */
       while (true) pop:
       {
@@ -90,6 +93,7 @@ namespace embree
           /* stop if we found a leaf node */
           if (unlikely(cur.isLeaf())) break;
           STAT3(normal.trav_nodes, 1, 1, 1);
+          if (unlikely(stats)) stats->nodes++;
 
           /* intersect node */
           size_t mask = 0;
@@ -108,6 +112,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves, 1, 1, 1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        if (unlikely(stats)) { stats->leaves++; stats->primitives += (unsigned int)num; }
 
         size_t lazy_node = 0;
         PrimitiveIntersectorK::intersect(This, pre, ray, k, context, prim, num, tray1, lazy_node);
@@ -162,6 +167,9 @@ namespace embree
 
       /* load ray */
       TravRayK<K, robust> tray(ray.org, ray.dir, single ? N : 0);
+
+      /* traversal statistics, only gathered if enabled in the context */
+      RTCTraversalStatistics* const stats = context->statistics();
       const vfloat<K> org_ray_tnear = max(ray.tnear(), 0.0f);
       const vfloat<K> org_ray_tfar  = max(ray.tfar , 0.0f);
 
@@ -271,6 +279,7 @@ namespace embree
             /* process nodes */
             const vbool<K> valid_node = tray.tfar > curDist;
             STAT3(normal.trav_nodes, 1, popcnt(valid_node), K);
+            if (unlikely(stats)) stats->nodes += (unsigned int)popcnt(valid_node);
             const NodeRef nodeRef = cur;
             const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
@@ -372,6 +381,10 @@ namespace embree
           STAT3(normal.trav_leaves, 1, popcnt(valid_leaf), K);
           if (unlikely(none(valid_leaf))) continue;
           size_t items; const Primitive* prim = (Primitive*)cur.leaf(items);
+          if (unlikely(stats)) {
+            stats->leaves += (unsigned int)popcnt(valid_leaf);
+            stats->primitives += (unsigned int)(items*popcnt(valid_leaf));
+          }
 
           size_t lazy_node = 0;
           PrimitiveIntersectorK::intersect(valid_leaf, This, pre, ray, context, prim, items, tray, lazy_node);
@@ -566,6 +579,9 @@ namespace embree
         /* load the ray into SIMD registers */
         TravRay<N,Nx,robust> tray1(k, tray.org, tray.dir, tray.rdir, tray.nearXYZ, tray.tnear[k], tray.tfar[k]);
 
+        /* traversal statistics, only gathered if enabled in the context */
+        RTCTraversalStatistics* const stats = context->statistics();
+
 	/* pop loop */
 	while (true) pop:
 	{
@@ -580,6 +596,7 @@ namespace embree
             /* stop if we found a leaf node */
             if (unlikely(cur.isLeaf())) break;
             STAT3(shadow.trav_nodes, 1, 1, 1);
+            if (unlikely(stats)) stats->nodes++;
 
             /* intersect node */
             size_t mask = 0;
@@ -598,6 +615,7 @@ namespace embree
           assert(cur != BVH::emptyNode);
           STAT3(shadow.trav_leaves, 1, 1, 1);
           size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          if (unlikely(stats)) { stats->leaves++; stats->primitives += (unsigned int)num; }
 
           size_t lazy_node = 0;
           if (PrimitiveIntersectorK::occluded(This, pre, ray, k, context, prim, num, tray1, lazy_node)) {
@@ -647,6 +665,9 @@ namespace embree
 
       /* load ray */
       TravRayK<K, robust> tray(ray.org, ray.dir, single ? N : 0);
+
+      /* traversal statistics, only gathered if enabled in the context */
+      RTCTraversalStatistics* const stats = context->statistics();
       const vfloat<K> org_ray_tnear = max(ray.tnear(), 0.0f);
       const vfloat<K> org_ray_tfar  = max(ray.tfar , 0.0f);
 
@@ -716,6 +737,7 @@ namespace embree
           /* process nodes */
           const vbool<K> valid_node = tray.tfar > curDist;
           STAT3(shadow.trav_nodes, 1, popcnt(valid_node), K);
+          if (unlikely(stats)) stats->nodes += (unsigned int)popcnt(valid_node);
           const NodeRef nodeRef = cur;
           const BaseNode* __restrict__ const node = nodeRef.baseNode(types);
 
@@ -777,6 +799,10 @@ namespace embree
         STAT3(shadow.trav_leaves, 1, popcnt(valid_leaf), K);
         if (unlikely(none(valid_leaf))) continue;
         size_t items; const Primitive* prim = (Primitive*) cur.leaf(items);
+        if (unlikely(stats)) {
+          stats->leaves += (unsigned int)popcnt(valid_leaf);
+          stats->primitives += (unsigned int)(items*popcnt(valid_leaf));
+        }
 
         size_t lazy_node = 0;
         terminated |= PrimitiveIntersectorK::occluded(!terminated, This, pre, ray, context, prim, items, tray, lazy_node);
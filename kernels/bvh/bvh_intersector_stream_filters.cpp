@@ -21,6 +21,46 @@ namespace embree
 {
   namespace isa
   {
+    /*! orders the rays of incoherent streams by direction octant and by
+     *  the Morton code of their quantized origin to improve memory
+     *  locality of the traversal */
+    struct RayStreamSorter
+    {
+      RayStreamSorter (Scene* scene)
+        : num(0)
+      {
+        const BBox3fa bounds = scene->getBounds();
+        if (bounds.empty()) {
+          base = Vec3fa(zero); scale = Vec3fa(zero);
+        } else {
+          base = bounds.lower; scale = Vec3fa(1023.0f)/max(bounds.size(),Vec3fa(1E-19f));
+        }
+      }
+
+      __forceinline void add(const Vec3fa& org, const Vec3fa& dir, unsigned int ref)
+      {
+        const Vec3fa q = clamp((org-base)*scale,Vec3fa(zero),Vec3fa(1023.0f));
+        const unsigned int octant = movemask(vfloat4(dir) < 0.0f) & 0x7;
+        const unsigned int code = (octant << 30) | bitInterleave((unsigned int)q.x,(unsigned int)q.y,(unsigned int)q.z);
+        keys[num++] = (uint64_t(code) << 32) | ref;
+      }
+
+      /*! sorts the rays and returns the sorted ray references */
+      __forceinline unsigned int* sort()
+      {
+        std::sort(keys,keys+num);
+        for (size_t i=0; i<num; i++)
+          refs[i] = (unsigned int) keys[i];
+        return refs;
+      }
+
+    public:
+      Vec3fa base, scale;
+      size_t num;
+      uint64_t keys[MAX_SORTED_STREAM_SIZE];
+      __aligned(64) unsigned int refs[MAX_SORTED_STREAM_SIZE];
+    };
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -145,6 +185,35 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (scene->device->stream_sort_size)
+      {
+        /* sort incoherent rays by direction and origin before forming packets */
+        const size_t blockSize = min(scene->device->stream_sort_size, MAX_SORTED_STREAM_SIZE);
+        RayStreamSorter sorter(scene);
+
+        for (size_t i = 0; i < N; i += blockSize)
+        {
+          sorter.num = 0;
+          for (size_t j = i; j < min(N, i + blockSize); j++)
+          {
+            const Ray& ray = rayN.getRayByOffset(j * stride);
+            if (unlikely(!(ray.tnear() <= ray.tfar))) continue;
+            sorter.add(ray.org, ray.dir, (unsigned int)j);
+          }
+          unsigned int* const rayIDs = sorter.sort();
+
+          for (size_t j = 0; j < sorter.num; j += K)
+          {
+            const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(sorter.num));
+            const vint<K> offset = *(vint<K>*)&rayIDs[j] * int(stride);
+
+            RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
+            scene->intersectors.intersect(valid, ray, context);
+            rayN.setHitByOffset(valid, offset, ray);
+          }
+        }
+      }
       else
       {
         /* fallback to packets */
@@ -287,6 +356,35 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (scene->device->stream_sort_size)
+      {
+        /* sort incoherent rays by direction and origin before forming packets */
+        const size_t blockSize = min(scene->device->stream_sort_size, MAX_SORTED_STREAM_SIZE);
+        RayStreamSorter sorter(scene);
+
+        for (size_t i = 0; i < N; i += blockSize)
+        {
+          sorter.num = 0;
+          for (size_t j = i; j < min(N, i + blockSize); j++)
+          {
+            const Ray& ray = rayN.getRayByIndex(j);
+            if (unlikely(!(ray.tnear() <= ray.tfar))) continue;
+            sorter.add(ray.org, ray.dir, (unsigned int)j);
+          }
+          unsigned int* const rayIDs = sorter.sort();
+
+          for (size_t j = 0; j < sorter.num; j += K)
+          {
+            const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(sorter.num));
+            const vint<K> index = *(vint<K>*)&rayIDs[j];
+
+            RayTypeK<K, intersect> ray = rayN.getRayByIndex(valid, index);
+            scene->intersectors.intersect(valid, ray, context);
+            rayN.setHitByIndex(valid, index, ray);
+          }
+        }
+      }
       else
       {
         /* fallback to packets */
@@ -424,6 +522,37 @@ namespace embree
             raysInOctant[curOctant] = 0;
           }
         }
+        else if (scene->device->stream_sort_size)
+        {
+          /* sort incoherent rays by direction and origin before forming packets */
+          RayStreamSOA rayN(rayData, K);
+          const size_t blockSize = min(scene->device->stream_sort_size, MAX_SORTED_STREAM_SIZE);
+          RayStreamSorter sorter(scene);
+
+          for (size_t i = 0; i < N*numPackets; i += blockSize)
+          {
+            sorter.num = 0;
+            for (size_t j = i; j < min(N*numPackets, i + blockSize); j++)
+            {
+              const size_t offset = (j / K) * stride + (j % K) * sizeof(float);
+              __aligned(64) Ray ray = rayN.getRayByOffset(offset);
+              if (unlikely(!(ray.tnear() <= ray.tfar))) continue;
+              sorter.add(ray.org, ray.dir, (unsigned int)offset);
+            }
+            unsigned int* const rayOffsets = sorter.sort();
+
+            for (size_t j = 0; j < sorter.num; j += K)
+            {
+              const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
+              const vbool<K> valid = vi < vint<K>(int(sorter.num));
+              const vint<K> offset = *(vint<K>*)&rayOffsets[j];
+
+              RayTypeK<K, intersect> ray = rayN.getRayByOffset(valid, offset);
+              scene->intersectors.intersect(valid, ray, context);
+              rayN.setHitByOffset(valid, offset, ray);
+            }
+          }
+        }
         else
         {
           /* fallback to packets */
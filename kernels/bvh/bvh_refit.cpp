@@ -22,7 +22,11 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
 #include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
 #include "../geometry/object.h"
+#include "../geometry/instance.h"
+#include "../geometry/subgrid.h"
+#include "../geometry/curveNv.h"
 
 namespace embree
 {
@@ -73,7 +77,8 @@ namespace embree
                                               size_t &subtrees,
                                               const size_t depth)
     {
-      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
+      /* unaligned nodes are refitted as a whole subtree */
+      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH || ref.isUnalignedNode()) 
       {
         assert(subtrees < MAX_NUM_SUB_TREES);
         subTrees[subtrees++] = ref;
@@ -97,7 +102,7 @@ namespace embree
 											const BBox3fa *const subTreeBounds,
                                             const size_t depth)
     {
-      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH) 
+      if (depth >= MAX_SUB_TREE_EXTRACTION_DEPTH || ref.isUnalignedNode()) 
       {
         assert(subtrees < MAX_NUM_SUB_TREES);
         assert(subTrees[subtrees] == ref);
@@ -146,6 +151,10 @@ namespace embree
       /* this is a leaf node */
       if (unlikely(ref.isLeaf()))
         return leafBounds.leafBounds(ref);
+
+      /* refit unaligned nodes of curve BVHs */
+      if (unlikely(ref.isUnalignedNode()))
+        return recurse_unaligned(ref);
       
       /* recurse if this is an internal node */
       AlignedNode* node = ref.alignedNode();
@@ -178,6 +187,136 @@ namespace embree
       return merge<N>(bounds);
     }
 
+    template<int N>
+    BBox3fa BVHNRefitter<N>::recurse_unaligned(NodeRef& ref)
+    {
+      UnalignedNode* node = ref.unalignedNode();
+      BBox3fa bounds = empty;
+
+      for (size_t i=0; i<N; i++)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode)) continue;
+        bounds.extend(recurse_bottom(child));
+
+        /* recover the orthonormal space of the child from its normalizing transformation */
+        const LinearSpace3fa xfm(Vec3fa(node->naabb.l.vx.x[i],node->naabb.l.vx.y[i],node->naabb.l.vx.z[i]),
+                                 Vec3fa(node->naabb.l.vy.x[i],node->naabb.l.vy.y[i],node->naabb.l.vy.z[i]),
+                                 Vec3fa(node->naabb.l.vz.x[i],node->naabb.l.vz.y[i],node->naabb.l.vz.z[i]));
+        const LinearSpace3fa rows = xfm.transposed();
+        const LinearSpace3fa space = LinearSpace3fa(normalize(rows.vx),normalize(rows.vy),normalize(rows.vz)).transposed();
+        node->setBounds(i,OBBox3fa(space,child_bounds(child,space)));
+      }
+      return bounds;
+    }
+
+    template<int N>
+    BBox3fa BVHNRefitter<N>::child_bounds(NodeRef& ref, const LinearSpace3fa& space)
+    {
+      /* leaves are bounded exactly in the space */
+      if (ref.isLeaf())
+        return leafBounds.leafBounds(ref,space);
+
+      /* the children of the already refitted node get transformed into the space */
+      BBox3fa bounds = empty;
+      if (ref.isUnalignedNode())
+      {
+        UnalignedNode* node = ref.unalignedNode();
+        for (size_t i=0; i<N; i++)
+        {
+          if (unlikely(node->child(i) == BVH::emptyNode)) continue;
+          const AffineSpace3fa xfm(LinearSpace3fa(Vec3fa(node->naabb.l.vx.x[i],node->naabb.l.vx.y[i],node->naabb.l.vx.z[i]),
+                                                  Vec3fa(node->naabb.l.vy.x[i],node->naabb.l.vy.y[i],node->naabb.l.vy.z[i]),
+                                                  Vec3fa(node->naabb.l.vz.x[i],node->naabb.l.vz.y[i],node->naabb.l.vz.z[i])),
+                                   Vec3fa(node->naabb.p.x[i],node->naabb.p.y[i],node->naabb.p.z[i]));
+          bounds.extend(xfmBounds(AffineSpace3fa(space)*rcp(xfm),BBox3fa(Vec3fa(0.0f),Vec3fa(1.0f))));
+        }
+      }
+      else
+      {
+        AlignedNode* node = ref.alignedNode();
+        for (size_t i=0; i<N; i++)
+        {
+          if (unlikely(node->child(i) == BVH::emptyNode)) continue;
+          bounds.extend(xfmBounds(AffineSpace3fa(space),node->bounds(i)));
+        }
+      }
+      return bounds;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::refitMB()
+    {
+      if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD)
+        bvh->bounds = recurse_mb(bvh->root,BBox1f(0.0f,1.0f),MAX_SUB_TREE_EXTRACTION_DEPTH);
+      else
+        bvh->bounds = recurse_mb(bvh->root,BBox1f(0.0f,1.0f),0);
+    }
+
+    template<int N>
+    LBBox3fa BVHNRefitter<N>::recurse_mb(NodeRef& ref, const BBox1f& time_range, const size_t depth)
+    {
+      /* this is a leaf node */
+      if (unlikely(ref.isLeaf()))
+        return leafBounds.leafLinearBounds(ref,time_range);
+
+      /* children of 4D nodes cover a sub range of the time range */
+      AlignedNodeMB* node = ref.alignedNodeMB();
+      const bool hasTimeSplits = ref.isAlignedNodeMB4D();
+      BBox1f time_ranges[N];
+      for (size_t i=0; i<N; i++) {
+        if (hasTimeSplits) time_ranges[i] = BBox1f(ref.alignedNodeMB4D()->lower_t[i],min(ref.alignedNodeMB4D()->upper_t[i],1.0f));
+        else               time_ranges[i] = time_range;
+      }
+
+      LBBox3fa bounds[N];
+      auto refitChild = [&] (size_t i)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode)) {
+          bounds[i] = empty;
+          return;
+        }
+        bounds[i] = recurse_mb(child,time_ranges[i],depth+1);
+        if (hasTimeSplits) ref.alignedNodeMB4D()->setBounds(i,bounds[i],time_ranges[i]);
+        else               node->setBounds(i,bounds[i],time_ranges[i]);
+      };
+
+      /* refit the upper levels in parallel */
+      if (depth+1 < MAX_SUB_TREE_EXTRACTION_DEPTH)
+        parallel_for(size_t(0), size_t(N), size_t(1), [&](const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++) refitChild(i);
+          });
+      else
+        for (size_t i=0; i<N; i++) refitChild(i);
+
+      /* the bounds of a 4D node have to be calculated for the full time range */
+      if (hasTimeSplits)
+        return subtree_linear_bounds(ref,time_range);
+
+      LBBox3fa lbounds = empty;
+      for (size_t i=0; i<N; i++)
+        lbounds.extend(bounds[i]);
+      return lbounds;
+    }
+
+    template<int N>
+    LBBox3fa BVHNRefitter<N>::subtree_linear_bounds(NodeRef& ref, const BBox1f& time_range)
+    {
+      if (ref.isLeaf())
+        return leafBounds.leafLinearBounds(ref,time_range);
+
+      LBBox3fa bounds = empty;
+      AlignedNodeMB* node = ref.alignedNodeMB();
+      for (size_t i=0; i<N; i++)
+      {
+        NodeRef& child = node->child(i);
+        if (unlikely(child == BVH::emptyNode)) continue;
+        bounds.extend(subtree_linear_bounds(child,time_range));
+      }
+      return bounds;
+    }
+
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
       : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh) {}
@@ -199,9 +338,73 @@ namespace embree
         refitter->refit();
     }
 
+    template<int N>
+    BVHNSceneRefitter<N>::BVHNSceneRefitter (BVH* bvh, Builder* builder, Scene* scene, Geometry::GTypeMask gtype, bool mblur)
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), scene(scene), gtype(gtype), mblur(mblur) {}
+
+    template<int N>
+    bool BVHNSceneRefitter<N>::canRefit()
+    {
+      if (bvh->root == BVH::emptyNode) return false;
+      if (geometries.size() != scene->size()) return false;
+
+      Scene::Iterator2 iter(scene,gtype,mblur);
+      for (size_t i=0; i<iter.size(); i++)
+      {
+        Geometry* geom = iter.at(i);
+        if (geom != geometries[i]) return false;
+        if (geom == nullptr) continue;
+        if (geom->quality != RTC_BUILD_QUALITY_REFIT) return false;
+        if (geom->numPrimitives != numPrimitives[i]) return false;
+        if (geom->topologyChanged()) return false;
+        if (!canRefitGeometry(geom)) return false;
+      }
+      return true;
+    }
+
+    template<int N>
+    void BVHNSceneRefitter<N>::build()
+    {
+      if (canRefit())
+      {
+        if (mblur) refitter->refitMB();
+        else       refitter->refit();
+        return;
+      }
+
+      builder->build();
+
+      /* remember the geometries the BVH got built over */
+      Scene::Iterator2 iter(scene,gtype,mblur);
+      geometries.resize(iter.size());
+      numPrimitives.resize(iter.size());
+      for (size_t i=0; i<iter.size(); i++) {
+        geometries[i] = iter.at(i);
+        numPrimitives[i] = geometries[i] ? geometries[i]->numPrimitives : 0;
+      }
+    }
+
+    template<int N>
+    void BVHNSceneRefitter<N>::deleteGeometry(size_t geomID)
+    {
+      if (geomID < geometries.size() && geometries[geomID])
+        geometries.clear();
+      builder->deleteGeometry(geomID);
+    }
+
+    template<int N>
+    void BVHNSceneRefitter<N>::clear()
+    {
+      geometries.clear();
+      numPrimitives.clear();
+      builder->clear();
+    }
+
     template class BVHNRefitter<4>;
+    template class BVHNSceneRefitter<4>;
 #if defined(__AVX__)
     template class BVHNRefitter<8>;
+    template class BVHNSceneRefitter<8>;
 #endif
     
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
@@ -242,6 +445,68 @@ namespace embree
     Builder* BVH8VirtualMeshBuilderSAH (void* bvh, UserGeometry* mesh, size_t mode);
     Builder* BVH8VirtualMeshRefitSAH (void* accel, UserGeometry* mesh, size_t mode) { return new BVHNRefitT<8,UserGeometry,Object>((BVH8*)accel,BVH8VirtualMeshBuilderSAH(accel,mesh,mode),mesh,mode); }
 #endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+    Builder* BVH4Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4Triangle4iMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<4,Triangle4i>((BVH4*)accel,BVH4Triangle4iMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_TRIANGLE_MESH); }
+#if  defined(__AVX__)
+    Builder* BVH8Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8Triangle4iMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<8,Triangle4i>((BVH8*)accel,BVH8Triangle4iMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_TRIANGLE_MESH); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_QUAD)
+    Builder* BVH4Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4Quad4iMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<4,Quad4i>((BVH4*)accel,BVH4Quad4iMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_QUAD_MESH); }
+#if  defined(__AVX__)
+    Builder* BVH8Quad4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8Quad4iMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<8,Quad4i>((BVH8*)accel,BVH8Quad4iMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_QUAD_MESH); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_USER)
+    Builder* BVH4VirtualMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4VirtualMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<4,Object>((BVH4*)accel,BVH4VirtualMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_USER_GEOMETRY); }
+#if  defined(__AVX__)
+    Builder* BVH8VirtualMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8VirtualMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<8,Object>((BVH8*)accel,BVH8VirtualMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_USER_GEOMETRY); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+    Builder* BVH4InstanceSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4InstanceMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4InstanceSceneRefitSAH   (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneT  <4,InstancePrimitive>((BVH4*)accel,BVH4InstanceSceneBuilderSAH  (accel,scene,mode),scene,Geometry::MTY_INSTANCE); }
+    Builder* BVH4InstanceMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<4,InstancePrimitive>((BVH4*)accel,BVH4InstanceMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_INSTANCE); }
+#if  defined(__AVX__)
+    Builder* BVH8InstanceSceneBuilderSAH   (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8InstanceMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8InstanceSceneRefitSAH   (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneT  <8,InstancePrimitive>((BVH8*)accel,BVH8InstanceSceneBuilderSAH  (accel,scene,mode),scene,Geometry::MTY_INSTANCE); }
+    Builder* BVH8InstanceMBSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneMBT<8,InstancePrimitive>((BVH8*)accel,BVH8InstanceMBSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_INSTANCE); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_GRID)
+    Builder* BVH4GridSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4GridSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneT<4,SubGridQBVH4>((BVH4*)accel,BVH4GridSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_GRID_MESH); }
+#if  defined(__AVX__)
+    Builder* BVH8GridSceneBuilderSAH (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8GridSceneRefitSAH (void* accel, Scene* scene, size_t mode) { return new BVHNRefitSceneT<8,SubGridQBVH8>((BVH8*)accel,BVH8GridSceneBuilderSAH(accel,scene,mode),scene,Geometry::MTY_GRID_MESH); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_CURVE)
+    Builder* BVH4Curve4vBuilder_OBB_New (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4Curve4iBuilder_OBB_New (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4Curve4vRefit_OBB (void* accel, Scene* scene, size_t mode) { return new BVHNRefitCurvesT<4,Curve4v>((BVH4*)accel,BVH4Curve4vBuilder_OBB_New(accel,scene,mode),scene,Geometry::MTY_CURVES); }
+    Builder* BVH4Curve4iRefit_OBB (void* accel, Scene* scene, size_t mode) { return new BVHNRefitCurvesT<4,Curve4i>((BVH4*)accel,BVH4Curve4iBuilder_OBB_New(accel,scene,mode),scene,Geometry::MTY_CURVES); }
+#if  defined(__AVX__)
+    Builder* BVH4Curve8iBuilder_OBB_New (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH8Curve8vBuilder_OBB_New (void* bvh, Scene* scene, size_t mode);
+    Builder* BVH4Curve8iRefit_OBB (void* accel, Scene* scene, size_t mode) { return new BVHNRefitCurvesT<4,Curve8i>((BVH4*)accel,BVH4Curve8iBuilder_OBB_New(accel,scene,mode),scene,Geometry::MTY_CURVES); }
+    Builder* BVH8Curve8vRefit_OBB (void* accel, Scene* scene, size_t mode) { return new BVHNRefitCurvesT<8,Curve8v>((BVH8*)accel,BVH8Curve8vBuilder_OBB_New(accel,scene,mode),scene,Geometry::MTY_CURVES); }
+#endif
 #endif
   }
 }
@@ -30,10 +30,24 @@ namespace embree
       /*! Type shortcuts */
       typedef BVHN<N> BVH;
       typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::AlignedNodeMB AlignedNodeMB;
+      typedef typename BVH::AlignedNodeMB4D AlignedNodeMB4D;
+      typedef typename BVH::UnalignedNode UnalignedNode;
       typedef typename BVH::NodeRef NodeRef;
 
-      struct LeafBoundsInterface {
+      struct LeafBoundsInterface
+      {
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
+
+        /*! bounds of the leaf in the space of some unaligned node */
+        virtual const BBox3fa leafBounds(NodeRef& ref, const LinearSpace3fa& space) const {
+          return xfmBounds(AffineSpace3fa(space),leafBounds(ref));
+        }
+
+        /*! linear bounds of the leaf for the specified time range */
+        virtual const LBBox3fa leafLinearBounds(NodeRef& ref, const BBox1f& time_range) const {
+          return LBBox3fa(leafBounds(ref));
+        }
       };
 
     public:
@@ -44,6 +58,9 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! refits the motion blur BVH */
+      void refitMB();
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -58,6 +75,18 @@ namespace embree
 
       /* single-threaded subtree refit */
       BBox3fa recurse_bottom(NodeRef& ref);
+
+      /* refits all children of an unaligned node in their own space */
+      BBox3fa recurse_unaligned(NodeRef& ref);
+
+      /* bounds of a refitted child in the space of its unaligned parent */
+      BBox3fa child_bounds(NodeRef& ref, const LinearSpace3fa& space);
+
+      /* motion blur subtree refit */
+      LBBox3fa recurse_mb(NodeRef& ref, const BBox1f& time_range, const size_t depth);
+
+      /* calculates the linear bounds of all leaves of a subtree for some time range */
+      LBBox3fa subtree_linear_bounds(NodeRef& ref, const BBox1f& time_range);
       
     public:
       BVH* bvh;                              //!< BVH to refit
@@ -103,5 +132,131 @@ namespace embree
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
     };
+
+    /*! Refits scene BVHs when only the vertices of their geometries
+        changed and falls back to the builder otherwise. */
+    template<int N>
+    class BVHNSceneRefitter : public Builder, public BVHNRefitter<N>::LeafBoundsInterface
+    {
+    public:
+      
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      
+    public:
+      BVHNSceneRefitter (BVH* bvh, Builder* builder, Scene* scene, Geometry::GTypeMask gtype, bool mblur);
+
+      virtual void build();
+
+      virtual void deleteGeometry(size_t geomID);
+      
+      virtual void clear();
+
+    private:
+      /*! checks if refitting the BVH from the last build is sufficient */
+      bool canRefit();
+
+    protected:
+      /*! checks if the leaves of some geometry support refitting */
+      virtual bool canRefitGeometry(const Geometry* geom) const { return true; }
+
+    protected:
+      BVH* bvh;
+      std::unique_ptr<Builder> builder;
+      std::unique_ptr<BVHNRefitter<N>> refitter;
+      Scene* scene;
+      Geometry::GTypeMask gtype;
+      bool mblur;
+      std::vector<Geometry*> geometries;     //!< geometries the BVH got built over
+      std::vector<unsigned int> numPrimitives; //!< number of primitives of these geometries
+    };
+
+    template<int N, typename Primitive>
+    class BVHNRefitSceneT : public BVHNSceneRefitter<N>
+    {
+    public:
+      
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      
+    public:
+      BVHNRefitSceneT (BVH* bvh, Builder* builder, Scene* scene, Geometry::GTypeMask gtype)
+        : BVHNSceneRefitter<N>(bvh,builder,scene,gtype,false) {}
+
+      virtual const BBox3fa leafBounds (NodeRef& ref) const
+      {
+        size_t num; char* prim = ref.leaf(num);
+        if (unlikely(ref == BVH::emptyNode)) return empty;
+
+        BBox3fa bounds = empty;
+        for (size_t i=0; i<num; i++)
+          bounds.extend(((Primitive*)prim)[i].update(this->scene));
+        return bounds;
+      }
+    };
+
+    template<int N, typename Primitive>
+    class BVHNRefitCurvesT : public BVHNSceneRefitter<N>
+    {
+    public:
+      
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      
+    public:
+      BVHNRefitCurvesT (BVH* bvh, Builder* builder, Scene* scene, Geometry::GTypeMask gtype)
+        : BVHNSceneRefitter<N>(bvh,builder,scene,gtype,false) {}
+
+      /* line segments are stored in different leaves */
+      virtual bool canRefitGeometry(const Geometry* geom) const {
+        return geom->getCurveBasis() != Geometry::GTY_BASIS_LINEAR;
+      }
+
+      virtual const BBox3fa leafBounds (NodeRef& ref) const
+      {
+        size_t num; char* prim = ref.leaf(num);
+        if (unlikely(ref == BVH::emptyNode)) return empty;
+        return Primitive::updateLeaf(prim,num,this->scene);
+      }
+
+      virtual const BBox3fa leafBounds (NodeRef& ref, const LinearSpace3fa& space) const
+      {
+        size_t num; char* prim = ref.leaf(num);
+        if (unlikely(ref == BVH::emptyNode)) return empty;
+        return Primitive::leafBounds(prim,num,this->scene,space);
+      }
+    };
+
+    template<int N, typename Primitive>
+    class BVHNRefitSceneMBT : public BVHNSceneRefitter<N>
+    {
+    public:
+      
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      
+    public:
+      BVHNRefitSceneMBT (BVH* bvh, Builder* builder, Scene* scene, Geometry::GTypeMask gtype)
+        : BVHNSceneRefitter<N>(bvh,builder,scene,gtype,true) {}
+
+      virtual const BBox3fa leafBounds (NodeRef& ref) const {
+        return leafLinearBounds(ref,BBox1f(0.0f,1.0f)).bounds();
+      }
+
+      virtual const LBBox3fa leafLinearBounds (NodeRef& ref, const BBox1f& time_range) const
+      {
+        size_t num; char* prim = ref.leaf(num);
+        if (unlikely(ref == BVH::emptyNode)) return empty;
+
+        LBBox3fa bounds = empty;
+        for (size_t i=0; i<num; i++)
+          bounds.extend(((Primitive*)prim)[i].linearBounds(this->scene,time_range));
+        return bounds;
+      }
+    };
   }
 }
@@ -0,0 +1,254 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_restructure.h"
+#include "../../common/algorithms/parallel_reduce.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N>
+    float BVHNRestructure<N>::restructure(BVH* bvh, size_t passes)
+    {
+      if (!bvh->root.isAlignedNode())
+        return 0.0f;
+
+      float reduction = 0.0f;
+      for (size_t pass=0; pass<passes; pass++)
+      {
+        /* every second pass starts one level deeper to move the treelet boundaries */
+        const float passReduction = restructure(bvh->root,0,pass%2 == 1);
+        reduction += passReduction;
+
+        if (passReduction == 0.0f && pass%2 == 1)
+          break;
+      }
+
+      /* the reduction gets reported with the statistics of the BVH */
+      bvh->restructureSAH += reduction;
+      return reduction;
+    }
+
+    template<int N>
+    float BVHNRestructure<N>::restructure(NodeRef ref, size_t depth, bool skip)
+    {
+      if (!ref.isAlignedNode())
+        return 0.0f;
+
+      AlignedNode* node = ref.alignedNode();
+      Subtree subtrees[maxTreeletSubtrees];
+      size_t numSubtrees = 0;
+      float reduction = 0.0f;
+
+      if (skip) {
+        for (size_t i=0; i<N; i++)
+          if (node->child(i) != BVH::emptyNode)
+            subtrees[numSubtrees++] = Subtree(node->child(i),node->bounds(i),1);
+      }
+      else
+        reduction = restructureTreelet(node,subtrees,numSubtrees);
+
+      /* continue with the subtrees of the treelet */
+      if (depth < parallelDepth)
+      {
+        reduction += parallel_reduce(size_t(0), numSubtrees, size_t(1), 0.0f, [&](const range<size_t>& r) -> float {
+            float red = 0.0f;
+            for (size_t i=r.begin(); i<r.end(); i++)
+              red += restructure(subtrees[i].ref,depth+1,false);
+            return red;
+          }, std::plus<float>());
+      }
+      else
+      {
+        for (size_t i=0; i<numSubtrees; i++)
+          reduction += restructure(subtrees[i].ref,depth+1,false);
+      }
+      return reduction;
+    }
+
+    template<int N>
+    float BVHNRestructure<N>::restructureTreelet(AlignedNode* root, Subtree* subtrees, size_t& numSubtrees)
+    {
+      /* form the treelet by opening the inner node of largest surface area */
+      AlignedNode* treeletNodes[maxTreeletSubtrees];
+      size_t numTreeletNodes = 0;
+      treeletNodes[numTreeletNodes++] = root;
+      for (size_t i=0; i<N; i++)
+        if (root->child(i) != BVH::emptyNode)
+          subtrees[numSubtrees++] = Subtree(root->child(i),root->bounds(i),1);
+
+      float oldCost = 0.0f;
+      while (numTreeletNodes < maxTreeletSubtrees)
+      {
+        ssize_t best = -1;
+        float bestArea = neg_inf;
+        for (size_t i=0; i<numSubtrees; i++)
+        {
+          if (!subtrees[i].ref.isAlignedNode()) continue;
+          const float A = halfArea(subtrees[i].bounds);
+          if (A > bestArea) { best = i; bestArea = A; }
+        }
+        if (best == -1) break;
+
+        AlignedNode* node = subtrees[best].ref.alignedNode();
+        size_t numChildren = 0;
+        for (size_t i=0; i<N; i++)
+          numChildren += node->child(i) != BVH::emptyNode;
+        if (numSubtrees-1+numChildren > maxTreeletSubtrees) break;
+
+        const size_t depth = subtrees[best].depth;
+        subtrees[best] = subtrees[--numSubtrees];
+        for (size_t i=0; i<N; i++)
+          if (node->child(i) != BVH::emptyNode)
+            subtrees[numSubtrees++] = Subtree(node->child(i),node->bounds(i),depth+1);
+
+        treeletNodes[numTreeletNodes++] = node;
+        oldCost += bestArea;
+      }
+
+      /* nothing to restructure if the root has only leaves as children */
+      if (numTreeletNodes == 1)
+        return 0.0f;
+
+      /* rebuild the treelet topology, the root node stays at index 0 */
+      TreeletNode nodes[maxTreeletSubtrees];
+      size_t numNodes = 0;
+      float newCost = 0.0f;
+      ssize_t rootIndex;
+      if (!buildTreelet(subtrees,0,numSubtrees,0,nodes,numNodes,numTreeletNodes,newCost,rootIndex))
+        return 0.0f;
+
+      /* only accept a noticeable improvement */
+      if (!(newCost < 0.999f*oldCost))
+        return 0.0f;
+
+      /* write the new treelet into the nodes of the old treelet */
+      for (size_t k=0; k<numNodes; k++)
+      {
+        AlignedNode* node = treeletNodes[k];
+        node->clear();
+        for (size_t c=0; c<nodes[k].numChildren; c++)
+        {
+          const ssize_t child = nodes[k].children[c];
+          if (child >= 0) node->set(c,BVH::encodeNode(treeletNodes[child]),nodes[child].bounds);
+          else            node->set(c,subtrees[-1-child].ref,subtrees[-1-child].bounds);
+        }
+      }
+      return oldCost-newCost;
+    }
+
+    template<int N>
+    bool BVHNRestructure<N>::buildTreelet(Subtree* subtrees, size_t begin, size_t end, size_t depth, TreeletNode* nodes, size_t& numNodes, size_t maxNodes, float& cost, ssize_t& index)
+    {
+      /* we can only reuse the nodes of the old treelet */
+      if (numNodes >= maxNodes)
+        return false;
+
+      index = numNodes++;
+      TreeletNode& node = nodes[index];
+      node.bounds = empty;
+      for (size_t i=begin; i<end; i++)
+        node.bounds.extend(subtrees[i].bounds);
+      if (depth > 0)
+        cost += halfArea(node.bounds);
+
+      /* split the subtrees into up to N groups, always splitting the group of largest surface area */
+      struct Group
+      {
+        size_t begin, end;
+        BBox3fa bounds;
+      };
+      Group groups[N];
+      size_t numGroups = 0;
+      groups[numGroups++] = { begin, end, node.bounds };
+
+      while (numGroups < N)
+      {
+        ssize_t best = -1;
+        float bestArea = neg_inf;
+        for (size_t g=0; g<numGroups; g++)
+        {
+          if (groups[g].end-groups[g].begin <= 1) continue;
+          const float A = halfArea(groups[g].bounds);
+          if (A > bestArea) { best = g; bestArea = A; }
+        }
+        if (best == -1) break;
+
+        /* find the best SAH split of the group along the centroids in any dimension */
+        const size_t gbegin = groups[best].begin;
+        const size_t gend   = groups[best].end;
+        float bestSAH = pos_inf;
+        size_t bestDim = 0, bestPos = gbegin+1;
+        for (size_t dim=0; dim<3; dim++)
+        {
+          std::sort(subtrees+gbegin,subtrees+gend,[&] (const Subtree& a, const Subtree& b) {
+              return center2(a.bounds)[dim] < center2(b.bounds)[dim];
+            });
+
+          float rightArea[maxTreeletSubtrees];
+          BBox3fa rightBounds = empty;
+          for (size_t i=gend-1; i>gbegin; i--) {
+            rightBounds.extend(subtrees[i].bounds);
+            rightArea[i-gbegin] = halfArea(rightBounds);
+          }
+          BBox3fa leftBounds = empty;
+          for (size_t i=gbegin+1; i<gend; i++)
+          {
+            leftBounds.extend(subtrees[i-1].bounds);
+            const float sah = halfArea(leftBounds)*float(i-gbegin) + rightArea[i-gbegin]*float(gend-i);
+            if (sah < bestSAH) { bestSAH = sah; bestDim = dim; bestPos = i; }
+          }
+        }
+        std::sort(subtrees+gbegin,subtrees+gend,[&] (const Subtree& a, const Subtree& b) {
+            return center2(a.bounds)[bestDim] < center2(b.bounds)[bestDim];
+          });
+
+        BBox3fa leftBounds = empty, rightBounds = empty;
+        for (size_t i=gbegin; i<bestPos; i++) leftBounds.extend(subtrees[i].bounds);
+        for (size_t i=bestPos; i<gend; i++) rightBounds.extend(subtrees[i].bounds);
+        groups[best] = { gbegin, bestPos, leftBounds };
+        groups[numGroups++] = { bestPos, gend, rightBounds };
+      }
+
+      /* create children, subtrees must not move deeper than in the old treelet */
+      node.numChildren = numGroups;
+      for (size_t g=0; g<numGroups; g++)
+      {
+        if (groups[g].end-groups[g].begin == 1)
+        {
+          if (subtrees[groups[g].begin].depth < depth+1)
+            return false;
+          node.children[g] = -1-ssize_t(groups[g].begin);
+        }
+        else
+        {
+          ssize_t child;
+          if (!buildTreelet(subtrees,groups[g].begin,groups[g].end,depth+1,nodes,numNodes,maxNodes,cost,child))
+            return false;
+          nodes[index].children[g] = child;
+        }
+      }
+      return true;
+    }
+
+    template class BVHNRestructure<4>;
+#if defined(__AVX__)
+    template class BVHNRestructure<8>;
+#endif
+  }
+}
@@ -0,0 +1,76 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "bvh.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Optimizes the topology of a BVH with aligned nodes by treelet
+     *  restructuring. A treelet is formed by repeatedly opening the
+     *  inner node of largest surface area below some node, and its
+     *  topology gets rebuilt from its subtrees using a greedy SAH
+     *  split. The restructured treelet reuses the nodes of the old
+     *  treelet and is only accepted if it has smaller SAH cost and
+     *  does not increase the depth of any subtree. */
+    template<int N>
+    class BVHNRestructure
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::NodeRef NodeRef;
+
+      /* maximal number of subtrees of a treelet */
+      static const size_t maxTreeletSubtrees = N*N;
+
+      /* treelets near the root get restructured in parallel */
+      static const size_t parallelDepth = 4;
+
+      struct Subtree
+      {
+        __forceinline Subtree () {}
+
+        __forceinline Subtree (NodeRef ref, const BBox3fa& bounds, size_t depth)
+          : ref(ref), bounds(bounds), depth(depth) {}
+
+        NodeRef ref;     //!< root of the subtree
+        BBox3fa bounds;  //!< bounds of the subtree
+        size_t depth;    //!< depth of the subtree inside the old treelet
+      };
+
+      struct TreeletNode
+      {
+        BBox3fa bounds;
+        size_t numChildren;
+        ssize_t children[N]; //!< index of treelet node if positive, or -1-index of subtree if negative
+      };
+
+    public:
+
+      /*! restructures the BVH in the specified number of passes and returns the unnormalized SAH cost reduction */
+      static float restructure(BVH* bvh, size_t passes);
+
+    private:
+      static float restructure(NodeRef ref, size_t depth, bool skip);
+      static float restructureTreelet(AlignedNode* root, Subtree* subtrees, size_t& numSubtrees);
+      static bool buildTreelet(Subtree* subtrees, size_t begin, size_t end, size_t depth, TreeletNode* nodes, size_t& numNodes, size_t maxNodes, float& cost, ssize_t& index);
+    };
+  }
+}
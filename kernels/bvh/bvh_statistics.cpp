@@ -38,6 +38,11 @@ namespace embree
     stream << "#bytes = " << std::setw(7) << std::setprecision(2) << totalBytes/1E6 << " MB (100.00%), ";
     stream << "#nodes = " << std::setw(7) << stat.size() << " (" << std::setw(6) << std::setprecision(2) << 100.0*stat.fillRate(bvh) << "% filled), ";
     stream << "#bytes/prim = " << std::setw(6) << std::setprecision(2) << double(totalBytes)/double(bvh->numPrimitives) << std::endl;
+    if (bvh->restructureSAH > 0.0f) {
+      const double restructureSAH = bvh->restructureSAH/bvh->getLinearBounds().expectedHalfArea();
+      stream << "  restructuring    : sah = " << std::setw(7) << std::setprecision(3) << totalSAH+restructureSAH << " -> " << totalSAH;
+      stream << " (" << std::setw(6) << std::setprecision(2) << 100.0*restructureSAH/(totalSAH+restructureSAH) << "% reduction)" << std::endl;
+    }
     if (stat.statAlignedNodes.numNodes    ) stream << "  alignedNodes     : "  << stat.statAlignedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statUnalignedNodes.numNodes  ) stream << "  unalignedNodes   : "  << stat.statUnalignedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statAlignedNodesMB.numNodes  ) stream << "  alignedNodesMB   : "  << stat.statAlignedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
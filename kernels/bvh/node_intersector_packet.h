@@ -721,6 +721,17 @@ namespace embree
       }
     };
 
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN1, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKFast<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        vmask = intersectQuantizedNodeK<N,K>((const typename BVHN<N>::QuantizedBaseNode*)node.quantizedNode(), i, ray, dist);
+        return true;
+      }
+    };
+
 
     /*! Intersects N nodes with K rays */
     template<int N, int K, bool robust>
@@ -19,6 +19,8 @@
 #include "default.h"
 #include "ray.h"
 #include "context.h"
+#include "point_query.h"
+#include "collide.h"
 
 namespace embree
 {
@@ -41,6 +43,25 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! writes the acceleration structure data to a binary stream */
+    virtual void save(std::ostream& stream) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support saving");
+    }
+
+    /*! restores the acceleration structure data from a binary stream written by save */
+    virtual void load(std::istream& stream) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure does not support loading");
+    }
+
+    /*! invokes the point query callback for all primitives near the query point, returns true if the query radius got reduced */
+    virtual bool pointQuery(RTCPointQuery* query, PointQueryContext* context) {
+      return false;
+    }
+
+    /*! reports all pairs of overlapping primitives of this and some other acceleration structure */
+    virtual void collide(AccelData* other, CollideContext* context) {
+    }
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -37,6 +37,23 @@ namespace embree
       bounds = accel->bounds;
     }
 
+    void save(std::ostream& stream) {
+      accel->save(stream);
+    }
+
+    void load(std::istream& stream) {
+      accel->load(stream);
+      bounds = accel->bounds;
+    }
+
+    bool pointQuery(RTCPointQuery* query, PointQueryContext* context) {
+      return accel->pointQuery(query,context);
+    }
+
+    void collide(AccelData* other, CollideContext* context) {
+      accel->collide(other->type == TY_ACCEL_INSTANCE ? ((AccelInstance*)other)->accel.get() : other,context);
+    }
+
     void deleteGeometry(size_t geomID) {
       if (accel  ) accel->deleteGeometry(geomID);
       if (builder) builder->deleteGeometry(geomID);
@@ -47,6 +64,10 @@ namespace embree
       if (builder) builder->clear();
     }
 
+    AccelData* getAccel() const {
+      return accel.get();
+    }
+
   private:
     std::unique_ptr<AccelData> accel;
     std::unique_ptr<Builder> builder;
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "acceln.h"
+#include "serialize.h"
 #include "ray.h"
 #include "../../include/embree3/rtcore_ray.h"
 #include "../../common/algorithms/parallel_for.h"
@@ -179,6 +180,49 @@ namespace embree
         accels[i]->build();
       });
 
+    accels_update();
+  }
+
+  void AccelN::accels_save(std::ostream& stream)
+  {
+    writeBinary(stream,accels.size());
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->save(stream);
+  }
+
+  void AccelN::accels_load(std::istream& stream)
+  {
+    if (readBinary<size_t>(stream) != accels.size())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"number of acceleration structures does not match");
+
+    /* reduce memory consumption */
+    accels.shrink_to_fit();
+
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->load(stream);
+
+    accels_update();
+  }
+
+  bool AccelN::accels_pointQuery(RTCPointQuery* query, PointQueryContext* context)
+  {
+    bool changed = false;
+    for (size_t i=0; i<accels.size(); i++)
+      if (!accels[i]->isEmpty())
+        changed |= accels[i]->pointQuery(query,context);
+    return changed;
+  }
+
+  void AccelN::accels_collide(AccelN* other, CollideContext* context)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+      for (size_t j=0; j<other->accels.size(); j++)
+        if (!accels[i]->isEmpty() && !other->accels[j]->isEmpty())
+          accels[i]->collide(other->accels[j],context);
+  }
+
+  void AccelN::accels_update()
+  {
     /* create list of non-empty acceleration structures */
     bool valid1 = true;
     bool valid4 = true;
@@ -49,6 +49,11 @@ namespace embree
     void accels_print(size_t ident);
     void accels_immutable();
     void accels_build ();
+    void accels_save (std::ostream& stream);
+    void accels_load (std::istream& stream);
+    bool accels_pointQuery (RTCPointQuery* query, PointQueryContext* context);
+    void accels_collide (AccelN* other, CollideContext* context);
+    void accels_update ();
     void accels_select(bool filter);
     void accels_deleteGeometry(size_t geomID);
     void accels_clear ();
@@ -486,6 +486,22 @@ namespace embree
       return size_t(1) << min(size_t(16),scale);
     }
 
+    /*! returns the thread block slot of the calling thread, on NUMA
+     *  systems the slots are partitioned among the nodes such that
+     *  blocks get first touched and filled by threads of a single node */
+    __forceinline size_t threadSlot() const
+    {
+      const size_t threadID = TaskScheduler::threadID();
+      const size_t numSlots = slotMask+1;
+      const size_t numNodes = getNumberOfNumaNodes();
+      if (likely(numNodes <= 1 || numSlots < numNodes))
+        return threadID & slotMask;
+
+      const size_t slotsPerNode = numSlots/numNodes;
+      const size_t node = getNumaNodeOfCurrentThread() % numNodes;
+      return node*slotsPerNode + threadID % slotsPerNode;
+    }
+
     /*! thread safe allocation of memory */
     void* malloc(size_t& bytes, size_t align, bool partial)
     {
@@ -494,8 +510,7 @@ namespace embree
       while (true)
       {
         /* allocate using current block */
-        size_t threadID = TaskScheduler::threadID();
-        size_t slot = threadID & slotMask;
+        size_t slot = threadSlot();
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -553,6 +568,27 @@ namespace embree
       freeBlocks = new (aptr) Block(SHARED,bytes-sizeof_Header,bytes-sizeof_Header,freeBlocks,ofs);
     }
 
+    /*! allocates a fully used block of the specified size, used to restore serialized data */
+    void* mallocBlock(size_t bytes)
+    {
+      Lock<SpinLock> lock(mutex);
+      bytes = (bytes+maxAlignment-1) & ~(maxAlignment-1);
+      Block* block = Block::create(device,bytes,bytes,usedBlocks,atype);
+      void* ptr = block->malloc(device,bytes,maxAlignment,false);
+      usedBlocks = block;
+      bytesUsed += bytes;
+      return ptr;
+    }
+
+    /*! calls the closure with the used memory region of each block */
+    template<typename Closure>
+    void forEachUsedBlock(const Closure& closure)
+    {
+      internal_fix_used_blocks();
+      for (Block* block = usedBlocks.load(); block; block = block->next)
+        closure(&block->data[0],block->getBlockUsedBytes());
+    }
+
     /* special allocation only used from morton builder only a single time for each build */
     void* specialAlloc(size_t bytes)
     {
@@ -0,0 +1,80 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  class Scene;
+
+  /*! state passed along the traversal of a collision query */
+  struct CollideContext
+  {
+    __forceinline CollideContext (Scene* scene0, Scene* scene1, RTCCollideFunction func, void* userPtr, bool swapped = false)
+      : scene0(scene0), scene1(scene1), func(func), userPtr(userPtr), swapped(swapped) {}
+
+    /*! returns the context to collide the BVHs in reversed order */
+    __forceinline CollideContext swap() const {
+      return CollideContext(scene1,scene0,func,userPtr,!swapped);
+    }
+
+  public:
+    Scene* scene0;
+    Scene* scene1;
+    RTCCollideFunction func;
+    void* userPtr;
+    bool swapped;            //!< if set, the primitive pairs get reported in swapped order
+  };
+
+  /*! batches collisions before passing them to the callback */
+  struct CollisionBuffer
+  {
+    static const size_t maxCollisions = 256;
+
+    __forceinline CollisionBuffer (const CollideContext* context)
+      : context(context), num(0) {}
+
+    __forceinline void add(unsigned int geomID0, unsigned int primID0, unsigned int geomID1, unsigned int primID1)
+    {
+      if (context->swapped) {
+        std::swap(geomID0,geomID1);
+        std::swap(primID0,primID1);
+      }
+
+      /* in self collisions report each pair once and skip primitives colliding with themselves */
+      if (context->scene0 == context->scene1 && (geomID0 > geomID1 || (geomID0 == geomID1 && primID0 >= primID1)))
+        return;
+
+      RTCCollision& c = collisions[num++];
+      c.geomID0 = geomID0; c.primID0 = primID0;
+      c.geomID1 = geomID1; c.primID1 = primID1;
+      if (num == maxCollisions) flush();
+    }
+
+    __forceinline void flush()
+    {
+      if (num) context->func(context->userPtr,collisions,(unsigned int)num);
+      num = 0;
+    }
+
+  public:
+    const CollideContext* context;
+    size_t num;
+    RTCCollision collisions[maxCollisions];
+  };
+}
@@ -27,7 +27,7 @@ namespace embree
   {
   public:
     __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context)
-      : scene(scene), user(user_context), instID(user_context->instID[0]) {}
+      : scene(scene), user(user_context) {}
 
     __forceinline bool hasContextFilter() const {
       return user->filter != nullptr;
@@ -40,10 +40,17 @@ namespace embree
     __forceinline bool isIncoherent() const {
       return embree::isIncoherent(user->flags);
     }
+
+    __forceinline RTCTraversalStatistics* statistics() const {
+      return getStatistics(user);
+    }
+
+    __forceinline float* transmittance() const {
+      return getTransmittance(user);
+    }
     
   public:
     Scene* scene;
     RTCIntersectContext* user;
-    unsigned int instID;
   };
 }
@@ -46,7 +46,6 @@ namespace embree
   DECLARE_SYMBOL2(RayStreamFilterFuncs,rayStreamFilterFuncs);
 
   static MutexSys g_mutex;
-  static std::map<Device*,size_t> g_cache_size_map;
   static std::map<Device*,size_t> g_num_threads_map;
 
   Device::Device (const char* cfg)
@@ -115,7 +114,6 @@ namespace embree
 
   Device::~Device ()
   {
-    setCacheSize(0);
     exitTaskingSystem();
   }
 
@@ -304,23 +302,10 @@ namespace embree
     return maxNumThreads;
   }
 
-  size_t getMaxCacheSize()
-  {
-    size_t maxCacheSize = 0;
-    for (std::map<Device*,size_t>::iterator i=g_cache_size_map.begin(); i!= g_cache_size_map.end(); i++)
-      maxCacheSize = max(maxCacheSize, (*i).second);
-    return maxCacheSize;
-  }
- 
   void Device::setCacheSize(size_t bytes) 
   {
 #if defined(EMBREE_GEOMETRY_SUBDIVISION)
-    Lock<MutexSys> lock(g_mutex);
-    if (bytes == 0) g_cache_size_map.erase(this);
-    else            g_cache_size_map[this] = bytes;
-    
-    size_t maxCacheSize = getMaxCacheSize();
-    resizeTessellationCache(maxCacheSize);
+    tessellationCache = make_unique(new SharedLazyTessellationCache(bytes));
 #endif
   }
 
@@ -491,6 +476,16 @@ namespace embree
     case RTC_DEVICE_PROPERTY_USER_GEOMETRY_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:      return tessellationCache->numHits;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:    return tessellationCache->numMisses;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return tessellationCache->numEvictions;
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:      return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:    return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return 0;
+#endif
+
 #if defined(TASKING_PPL)
     case RTC_DEVICE_PROPERTY_JOIN_COMMIT_SUPPORTED: return 0;
 #elif defined(TASKING_TBB) && (TBB_INTERFACE_VERSION_MAJOR < 8)
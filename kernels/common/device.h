@@ -24,6 +24,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class SharedLazyTessellationCache;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -58,7 +59,7 @@ namespace embree
     /*! invokes the memory monitor callback */
     void memoryMonitor(ssize_t bytes, bool post);
 
-    /*! sets the size of the software cache. */
+    /*! creates a tessellation cache of specified size for this device */
     void setCacheSize(size_t bytes);
 
     /*! sets a property */
@@ -94,5 +95,10 @@ namespace embree
     
     /* ray streams filter */
     RayStreamFilterFuncs rayStreamFilters;
+
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    /* tessellation cache of this device */
+    std::unique_ptr<SharedLazyTessellationCache> tessellationCache;
+#endif
   };
 }
@@ -49,6 +49,7 @@ namespace embree
     : device(device), scene(nullptr), userPtr(nullptr),
       geomID(0), numPrimitives(numPrimitives), numTimeSteps(unsigned(numTimeSteps)), fnumTimeSegments(float(numTimeSteps-1)),
       mask(-1),
+      opacity(1.0f),
       gtype(gtype),
       quality(RTC_BUILD_QUALITY_MEDIUM),
       state(MODIFIED),
@@ -183,6 +184,17 @@ namespace embree
     enabled = false;
   }
 
+  void Geometry::setOpacity (float opacity_in)
+  {
+    if (!(getTypeMask() & (MTY_TRIANGLE_MESH | MTY_QUAD_MESH | MTY_CURVES | MTY_SUBDIV_MESH | MTY_GRID_MESH)))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"opacity not supported for this geometry");
+
+    if (!(opacity_in >= 0.0f && opacity_in <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"opacity has to be in the range [0,1]");
+
+    opacity = opacity_in;
+  }
+
   void Geometry::setUserData (void* ptr)
   {
     userPtr = ptr;
@@ -197,12 +197,23 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! returns true if topology changed */
+    virtual bool topologyChanged() const {
+      return numPrimitivesChanged;
+    }
+
     /*! sets the build quality */
     void setBuildQuality(RTCBuildQuality quality_in)
     {
       this->quality = quality_in;
       Geometry::update();
     }
+
+    /*! sets the constant opacity used when accumulating transmittance */
+    void setOpacity(float opacity);
+
+    /*! returns true if hits of occlusion rays attenuate the ray instead of occluding it */
+    __forceinline bool isTransparent() const { return opacity < 1.0f; }
     
     /*! for all geometries */
   public:
@@ -247,6 +258,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! enables or disables view dependent tessellation for some camera position */
+    virtual void setAdaptiveTessellation(bool enable, const Vec3fa& position, float minLevel, float maxLevel) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set user data pointer. */
     virtual void setUserData(void* ptr);
       
@@ -301,6 +317,10 @@ namespace embree
     /*! for triangle meshes and bezier curves only */
   public:
 
+    /*! Sets the dequantization transformation of compressed vertex formats. */
+    virtual void setVertexDequantization(const Vec3fa& scale, const Vec3fa& offset) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
 
     /*! Sets ray mask. */
     virtual void setMask(unsigned mask) { 
@@ -433,6 +453,7 @@ namespace embree
     unsigned int numTimeSteps;     //!< number of time steps
     float fnumTimeSegments;    //!< number of time segments (precalculation)
     unsigned int mask;             //!< for masking out geometry
+    float opacity;                 //!< constant opacity for occlusion rays that accumulate transmittance
     struct {
       GType gtype : 6;                 //!< geometry type
       RTCBuildQuality quality : 3;    //!< build quality for geometry
@@ -18,6 +18,7 @@
 
 #include "default.h"
 #include "ray.h"
+#include "instance_stack.h"
 
 namespace embree
 {
@@ -29,8 +30,12 @@ namespace embree
     __forceinline HitK() {}
 
     /* Constructs a hit */
-    __forceinline HitK(const vuint<K>& instID, const vuint<K>& geomID, const vuint<K>& primID, const vfloat<K>& u, const vfloat<K>& v, const Vec3vf<K>& Ng)
-      : Ng(Ng), u(u), v(v), primID(primID), geomID(geomID), instID(instID) {}
+    __forceinline HitK(const RTCIntersectContext* context, const vuint<K>& geomID, const vuint<K>& primID, const vfloat<K>& u, const vfloat<K>& v, const Vec3vf<K>& Ng)
+      : Ng(Ng), u(u), v(v), primID(primID), geomID(geomID)
+    {
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        instID[l] = context->instID[l];
+    }
 
     /* Returns the size of the hit */
     static __forceinline size_t size() { return K; }
@@ -41,7 +46,7 @@ namespace embree
     vfloat<K> v;         // barycentric v coordinate of hit
     vuint<K> primID;      // primitive ID
     vuint<K> geomID;      // geometry ID
-    vuint<K> instID;      // instance ID
+    vuint<K> instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
   };
 
   /* Specialization for a single hit */
@@ -52,8 +57,11 @@ namespace embree
     __forceinline HitK() {}
 
     /* Constructs a hit */
-    __forceinline HitK(unsigned int instID, unsigned int geomID, unsigned int primID, float u, float v, const Vec3fa& Ng)
-      : Ng(Ng.x,Ng.y,Ng.z), u(u), v(v), primID(primID), geomID(geomID), instID(instID) {}
+    __forceinline HitK(const RTCIntersectContext* context, unsigned int geomID, unsigned int primID, float u, float v, const Vec3fa& Ng)
+      : Ng(Ng.x,Ng.y,Ng.z), u(u), v(v), primID(primID), geomID(geomID)
+    {
+      instance_id_stack::copy(context->instID, instID);
+    }
 
     /* Returns the size of the hit */
     static __forceinline size_t size() { return 1; }
@@ -64,7 +72,7 @@ namespace embree
     float v;         // barycentric v coordinate of hit
     unsigned int primID;      // primitive ID
     unsigned int geomID;      // geometry ID
-    unsigned int instID;      // instance ID
+    unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance ID
   };
 
   /* Shortcuts */
@@ -83,7 +91,7 @@ namespace embree
                 << "  v = " << ray.v << std::endl
                 << "  primID = " << ray.primID <<  std::endl
                 << "  geomID = " << ray.geomID << std::endl
-                << "  instID = " << ray.instID << std::endl
+                << "  instID = " << ray.instID[0] << std::endl
                 << "}";
   }
 
@@ -94,7 +102,7 @@ namespace embree
     ray.v    = hit.v;
     ray.primID = hit.primID;
     ray.geomID = hit.geomID;
-    ray.instID = hit.instID;
+    instance_id_stack::copy(hit.instID, ray.instID);
   }
 
   template<int K>
@@ -107,6 +115,7 @@ namespace embree
     vfloat<K>::storeu(mask,&ray.v, hit.v);
     vuint<K>::storeu(mask,&ray.primID, hit.primID);
     vuint<K>::storeu(mask,&ray.geomID, hit.geomID);
-    vuint<K>::storeu(mask,&ray.instID, hit.instID);
+    for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      vuint<K>::storeu(mask,&ray.instID[l], hit.instID[l]);
   }
 }
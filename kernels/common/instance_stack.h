@@ -0,0 +1,106 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "rtcore.h"
+
+namespace embree
+{
+  /* Utility functions to maintain the stack of instance IDs stored in
+   * the intersection context. The stack is terminated by
+   * RTC_INVALID_GEOMETRY_ID, thus entries above the top of the stack
+   * are always invalid. */
+  namespace instance_id_stack
+  {
+    /* Pushes the geomID of an entered instance and counts the instance
+     * transition in the traversal statistics. Returns false if the
+     * stack is full, in which case the instance has to be skipped. */
+    __forceinline bool push(RTCIntersectContext* context, unsigned int instID)
+    {
+      RTCTraversalStatistics* stats = getStatistics(context);
+      if (unlikely(stats)) stats->instances++;
+
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      const bool spaceAvailable = context->instStackSize < RTC_MAX_INSTANCE_LEVEL_COUNT;
+      assert(spaceAvailable);
+      if (likely(spaceAvailable))
+        context->instID[context->instStackSize++] = instID;
+      return spaceAvailable;
+#else
+      const bool spaceAvailable = context->instID[0] == RTC_INVALID_GEOMETRY_ID;
+      assert(spaceAvailable);
+      if (likely(spaceAvailable))
+        context->instID[0] = instID;
+      return spaceAvailable;
+#endif
+    }
+
+    /* Pops the geomID of the instance that is left */
+    __forceinline void pop(RTCIntersectContext* context)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      assert(context->instStackSize > 0);
+      context->instID[--context->instStackSize] = RTC_INVALID_GEOMETRY_ID;
+#else
+      assert(context->instID[0] != RTC_INVALID_GEOMETRY_ID);
+      context->instID[0] = RTC_INVALID_GEOMETRY_ID;
+#endif
+    }
+
+    /* Copies the stack up to and including its terminating entry */
+    __forceinline void copy(const unsigned int* src, unsigned int* dst)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        dst[l] = src[l];
+        if (src[l] == RTC_INVALID_GEOMETRY_ID) break;
+      }
+#else
+      dst[0] = src[0];
+#endif
+    }
+
+    /* Copies the stack into lane k of a stack of ray packets */
+    template<typename vuintK>
+    __forceinline void copy(const unsigned int* src, vuintK* dst, size_t k)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        dst[l][k] = src[l];
+        if (src[l] == RTC_INVALID_GEOMETRY_ID) break;
+      }
+#else
+      dst[0][k] = src[0];
+#endif
+    }
+
+    /* Copies the stack into all active lanes of a stack of ray packets */
+    template<typename vboolK, typename vuintK>
+    __forceinline void copy(const vboolK& valid, const unsigned int* src, vuintK* dst)
+    {
+#if RTC_MAX_INSTANCE_LEVEL_COUNT > 1
+      for (unsigned int l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++) {
+        vuintK::store(valid,&dst[l],src[l]);
+        if (src[l] == RTC_INVALID_GEOMETRY_ID) break;
+      }
+#else
+      vuintK::store(valid,&dst[0],src[0]);
+#endif
+    }
+  }
+}
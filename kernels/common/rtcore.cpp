@@ -203,6 +203,7 @@ namespace embree
         quality != RTC_BUILD_QUALITY_MEDIUM &&
         quality != RTC_BUILD_QUALITY_HIGH)
       throw std::runtime_error("invalid build quality");
+    scene->waitForCommitAsync();
     scene->setBuildQuality(quality);
     RTC_CATCH_END2(scene);
   }
@@ -213,6 +214,7 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcSetSceneFlags);
     RTC_VERIFY_HANDLE(hscene);
+    scene->waitForCommitAsync();
     scene->setSceneFlags(flags);
     RTC_CATCH_END2(scene);
   }
@@ -234,6 +236,7 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcCommitScene);
     RTC_VERIFY_HANDLE(hscene);
+    scene->waitForCommitAsync();
     scene->commit(false);
     RTC_CATCH_END2(scene);
   }
@@ -244,7 +247,40 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcJoinCommitScene);
     RTC_VERIFY_HANDLE(hscene);
-    scene->commit(true);
+    if (!scene->waitForCommitAsync())
+      scene->commit(true);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcCommitSceneAsync (RTCScene hscene, RTCCommitSceneFunction callback, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->commitAsync(callback,userPtr);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSaveScene (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSaveScene);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->save(filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcLoadScene (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLoadScene);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->load(filename);
     RTC_CATCH_END2(scene);
   }
 
@@ -540,7 +576,8 @@ namespace embree
     if (((size_t)rayhit->hit.v     ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.v not aligned to 4 bytes");   
     if (((size_t)rayhit->hit.geomID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.geomID not aligned to 4 bytes");   
     if (((size_t)rayhit->hit.primID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.primID not aligned to 4 bytes");   
-    if (((size_t)rayhit->hit.instID) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      if (((size_t)rayhit->hit.instID[l]) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->hit.instID not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N,N,N);
     IntersectContext context(scene,user_context);
@@ -794,6 +831,49 @@ namespace embree
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API bool rtcPointQuery(RTCScene hscene, RTCPointQuery* query, RTCPointQueryFunction queryFunc, void* userPtr)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQuery);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(query);
+    RTC_VERIFY_HANDLE(queryFunc);
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    return scene->pointQuery(query,queryFunc,userPtr);
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
+  RTC_API bool rtcClosestPoint(RTCScene hscene, RTCPointQuery* query, RTCClosestPoint* result)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcClosestPoint);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(query);
+    RTC_VERIFY_HANDLE(result);
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");
+    return scene->closestPoint(query,result);
+    RTC_CATCH_END2(scene);
+    return false;
+  }
+
+  RTC_API void rtcCollide(RTCScene hscene0, RTCScene hscene1, RTCCollideFunction callback, void* userPtr)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollide);
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    RTC_VERIFY_HANDLE(callback);
+    if (scene0->device != scene1->device)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"inputs are from different devices");
+    scene0->collide(scene1,callback,userPtr);
+    RTC_CATCH_END2(scene0);
+  }
+
   RTC_API void rtcRetainScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1132,6 +1212,16 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryOpacity (RTCGeometry hgeometry, float opacity) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryOpacity);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setOpacity(opacity);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometrySubdivisionMode (RTCGeometry hgeometry, unsigned topologyID, RTCSubdivisionMode mode) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1225,6 +1315,7 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcEnableGeometry);
     RTC_VERIFY_HANDLE(hgeometry);
+    if (geometry->scene) geometry->scene->waitForCommitAsync();
     geometry->enable();
     RTC_CATCH_END2(geometry);
   }
@@ -1239,12 +1330,25 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryVertexDequantization (RTCGeometry hgeometry, const float* scale, const float* offset)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryVertexDequantization);
+    RTC_VERIFY_HANDLE(hgeometry);
+    RTC_VERIFY_HANDLE(scale);
+    RTC_VERIFY_HANDLE(offset);
+    geometry->setVertexDequantization(Vec3fa(scale[0],scale[1],scale[2]),Vec3fa(offset[0],offset[1],offset[2]));
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcDisableGeometry (RTCGeometry hgeometry) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcDisableGeometry);
     RTC_VERIFY_HANDLE(hgeometry);
+    if (geometry->scene) geometry->scene->waitForCommitAsync();
     geometry->disable();
     RTC_CATCH_END2(geometry);
   }
@@ -1259,6 +1363,17 @@ namespace embree
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryAdaptiveTessellation (RTCGeometry hgeometry, const float* position, float minLevel, float maxLevel)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryAdaptiveTessellation);
+    RTC_VERIFY_HANDLE(hgeometry);
+    if (position) geometry->setAdaptiveTessellation(true,Vec3fa(position[0],position[1],position[2]),minLevel,maxLevel);
+    else          geometry->setAdaptiveTessellation(false,Vec3fa(zero),minLevel,maxLevel);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1420,6 +1535,7 @@ namespace embree
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcCommitGeometry);
     RTC_VERIFY_HANDLE(hgeometry);
+    if (geometry->scene) geometry->scene->waitForCommitAsync();
     return geometry->commit();
     RTC_CATCH_END2(geometry);
   }
@@ -1434,6 +1550,7 @@ namespace embree
     RTC_VERIFY_HANDLE(hgeometry);
     if (scene->device != geometry->device)
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"inputs are from different devices");
+    scene->waitForCommitAsync();
     return scene->bind(RTC_INVALID_GEOMETRY_ID,geometry);
     RTC_CATCH_END2(scene);
     return -1;
@@ -1450,6 +1567,7 @@ namespace embree
     RTC_VERIFY_GEOMID(geomID);
     if (scene->device != geometry->device)
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"inputs are from different devices");
+    scene->waitForCommitAsync();
     scene->bind(geomID,geometry);
     RTC_CATCH_END2(scene);
   }
@@ -1461,6 +1579,7 @@ namespace embree
     RTC_TRACE(rtcDetachGeometry);
     RTC_VERIFY_HANDLE(hscene);
     RTC_VERIFY_GEOMID(geomID);
+    scene->waitForCommitAsync();
     scene->detachGeometry(geomID);
     RTC_CATCH_END2(scene);
   }
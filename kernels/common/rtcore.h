@@ -30,6 +30,16 @@ namespace embree
   __forceinline bool isCoherent  (RTCIntersectContextFlags flags) { return (flags & RTC_INTERSECT_CONTEXT_FLAG_COHERENT) == RTC_INTERSECT_CONTEXT_FLAG_COHERENT; }
   __forceinline bool isIncoherent(RTCIntersectContextFlags flags) { return (flags & RTC_INTERSECT_CONTEXT_FLAG_COHERENT) == RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT; }
 
+  /*! returns the traversal statistics to fill, or nullptr if gathering statistics is disabled */
+  __forceinline RTCTraversalStatistics* getStatistics(const RTCIntersectContext* context) {
+    return (context->flags & RTC_INTERSECT_CONTEXT_FLAG_STATISTICS) ? context->stats : nullptr;
+  }
+
+  /*! returns the per ray transmittance to accumulate, or nullptr if accumulating transmittance is disabled */
+  __forceinline float* getTransmittance(const RTCIntersectContext* context) {
+    return (context->flags & RTC_INTERSECT_CONTEXT_FLAG_TRANSMITTANCE) ? context->transmittance : nullptr;
+  }
+
 #if defined(TASKING_TBB) && (TBB_INTERFACE_VERSION_MAJOR >= 8)
 #  define USE_TASK_ARENA 1
 #else
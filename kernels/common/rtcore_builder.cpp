@@ -28,15 +28,65 @@
 
 #include "../builders/bvh_builder_sah.h"
 #include "../builders/bvh_builder_morton.h"
+#include "../builders/bvh_builder_msmblur.h"
 
 namespace embree
 { 
   namespace isa // FIXME: support more ISAs for builders
   {
+    /* node of the BVH topology recorded for refitting */
+    struct RefitNode
+    {
+      static const unsigned int INVALID = -1;
+
+      void* ptr;          //!< user node or leaf
+      size_t begin;       //!< first primitive of a leaf
+      size_t size;        //!< number of primitives of the subtree
+      unsigned int child; //!< first child of an inner node, INVALID for leaves
+      unsigned int next;  //!< next sibling
+    };
+
+    /* user node together with the index of its refit node */
+    struct BuildRef
+    {
+      __forceinline BuildRef () {}
+
+      __forceinline BuildRef (void* ptr, unsigned int id)
+        : ptr(ptr), id(id) {}
+
+      void* ptr;
+      unsigned int id;
+    };
+
+    /* reference to the children of a flat node or the primitives of a flat leaf */
+    struct FlatRef
+    {
+      __forceinline FlatRef () {}
+
+      __forceinline FlatRef (unsigned int offset, unsigned int count)
+        : offset(offset), count(count) {}
+
+      unsigned int offset;
+      unsigned int count;
+    };
+
+    __forceinline void setFlatNode(RTCBuildNode& node, const BBox3fa& bounds)
+    {
+      node.lower_x = bounds.lower.x; node.lower_y = bounds.lower.y; node.lower_z = bounds.lower.z;
+      node.upper_x = bounds.upper.x; node.upper_y = bounds.upper.y; node.upper_z = bounds.upper.z;
+    }
+
+    __forceinline void setFlatNode(RTCBuildNode& node, const FlatRef& ref)
+    {
+      node.offset = ref.offset;
+      node.count = ref.count;
+    }
+
     struct BVH : public RefCount
     {
       BVH (Device* device)
-        : device(device), allocator(device,true), morton_src(device,0), morton_tmp(device,0)
+        : device(device), allocator(device,true), morton_src(device,0), morton_tmp(device,0),
+          refit_nodes(device,0), refit_count(0), refit_root(RefitNode::INVALID), node_count(0)
       {
         device->refInc();
       }
@@ -45,11 +95,83 @@ namespace embree
         device->refDec();
       }
 
+      /* records a leaf when refitting is enabled */
+      __forceinline unsigned int recordLeaf(void* ptr, size_t begin, size_t size)
+      {
+        if (refit_nodes.size() == 0) return RefitNode::INVALID;
+        const unsigned int id = (unsigned int) refit_count++;
+        assert(id < refit_nodes.size());
+        RefitNode& node = refit_nodes[id];
+        node.ptr = ptr;
+        node.begin = begin;
+        node.size = size;
+        node.child = RefitNode::INVALID;
+        node.next = RefitNode::INVALID;
+        return id;
+      }
+
+      /* records an inner node and links its children when refitting is enabled */
+      __forceinline unsigned int recordNode(void* ptr, const BuildRef* children, size_t N)
+      {
+        if (refit_nodes.size() == 0) return RefitNode::INVALID;
+        const unsigned int id = (unsigned int) refit_count++;
+        assert(id < refit_nodes.size());
+        RefitNode& node = refit_nodes[id];
+        node.ptr = ptr;
+        node.begin = 0;
+        node.size = 0;
+        node.child = children[0].id;
+        node.next = RefitNode::INVALID;
+        for (size_t i=0; i<N; i++) {
+          node.size += refit_nodes[children[i].id].size;
+          refit_nodes[children[i].id].next = i+1 < N ? children[i+1].id : RefitNode::INVALID;
+        }
+        return id;
+      }
+
     public:
       Device* device;
       FastAllocator allocator;
       mvector<BVHBuilderMorton::BuildPrim> morton_src;
       mvector<BVHBuilderMorton::BuildPrim> morton_tmp;
+      mvector<RefitNode> refit_nodes;       //!< BVH topology for refitting, empty if refitting is disabled
+      std::atomic<size_t> refit_count;      //!< number of recorded refit nodes
+      unsigned int refit_root;              //!< refit node of the root
+      size_t node_count;                    //!< number of nodes written by the last flat build
+    };
+
+    /* recalculates motion blur build primitives for some time range */
+    struct RecalculateBuildPrimitiveMB
+    {
+      __forceinline RecalculateBuildPrimitiveMB (const RTCBuildPrimitiveMB* prims, RTCPrimitiveLinearBoundsFunction primitiveLinearBounds, void* userPtr)
+        : prims(prims), primitiveLinearBounds(primitiveLinearBounds), userPtr(userPtr) {}
+
+      __forceinline PrimRefMB operator() (const PrimRefMB& prim, const BBox1f time_range) const
+      {
+        const LBBox3fa lbounds = linearBounds(prim,time_range);
+        const unsigned num_time_segments = prim.totalTimeSegments();
+        const range<int> tbounds = getTimeSegmentRange(time_range, (float)num_time_segments);
+        return PrimRefMB (lbounds, tbounds.size(), num_time_segments, prim.ID());
+      }
+
+      __forceinline LBBox3fa linearBounds(const PrimRefMB& prim, const BBox1f time_range) const {
+        return linearBounds(prims[prim.ID()],time_range);
+      }
+
+      /* uses the callback if present, and interpolates the linear bounds of the primitive otherwise */
+      __forceinline LBBox3fa linearBounds(const RTCBuildPrimitiveMB& prim, const BBox1f time_range) const
+      {
+        if (primitiveLinearBounds) {
+          LBBox3fa lbounds;
+          primitiveLinearBounds(&prim,time_range.lower,time_range.upper,(RTCLinearBounds*)&lbounds,userPtr);
+          return lbounds;
+        }
+        return ((const LBBox3fa&) prim.bounds).interpolate(time_range);
+      }
+
+      const RTCBuildPrimitiveMB* prims;
+      RTCPrimitiveLinearBoundsFunction primitiveLinearBounds;
+      void* userPtr;
     };
 
     RTC_API RTCBVH rtcNewBVH(RTCDevice device)
@@ -63,6 +185,47 @@ namespace embree
       return nullptr;
     }
 
+    /* function that splits a build primitive */
+    struct SpatialSplitter
+    {
+      SpatialSplitter (RTCSplitPrimitiveFunction splitPrimitive, unsigned geomID, unsigned primID, void* userPtr)
+        : splitPrimitive(splitPrimitive), geomID(geomID), primID(primID), userPtr(userPtr) {}
+      
+      __forceinline void operator() (PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const 
+      {
+        prim.geomIDref() &= BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK;
+        splitPrimitive((RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
+        left_o.geomIDref()  = geomID; left_o.primIDref()  = primID;
+        right_o.geomIDref() = geomID; right_o.primIDref() = primID;
+      }
+
+      __forceinline void operator() (const BBox3fa& box, const size_t dim, const float pos, BBox3fa& left_o, BBox3fa& right_o) const 
+      {
+        PrimRef prim(box,geomID & BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK,primID);
+        splitPrimitive((RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
+      }
+ 
+      RTCSplitPrimitiveFunction splitPrimitive;
+      unsigned geomID;
+      unsigned primID;
+      void* userPtr;
+    };
+
+    /* reorders the primitives into the morton order of the last morton build */
+    void sortMortonPrimitives(BVH* bvh, PrimRef* prims, size_t primitiveCount)
+    {
+      const mvector<BVHBuilderMorton::BuildPrim>& morton_src = bvh->morton_src;
+      mvector<PrimRef> sorted(bvh->device,primitiveCount);
+      parallel_for ( size_t(0), primitiveCount, [&](const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            sorted[i] = prims[morton_src[i].index];
+        });
+      parallel_for ( size_t(0), primitiveCount, [&](const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            prims[i] = sorted[i];
+        });
+    }
+
     void* rtcBuildBVHMorton(const RTCBuildArguments* arguments)
     {
       BVH* bvh = (BVH*) arguments->bvh;
@@ -103,7 +266,7 @@ namespace embree
         });
 
       /* start morton build */
-      std::pair<void*,BBox3fa> root = BVHBuilderMorton::build<std::pair<void*,BBox3fa>>(
+      std::pair<BuildRef,BBox3fa> root = BVHBuilderMorton::build<std::pair<BuildRef,BBox3fa>>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::CachedAllocator { 
@@ -116,28 +279,37 @@ namespace embree
         },
         
         /* lambda function that sets bounds */
-        [&] (void* node, const std::pair<void*,BBox3fa>* children, size_t N) -> std::pair<void*,BBox3fa>
+        [&] (void* node, const std::pair<BuildRef,BBox3fa>* children, size_t N) -> std::pair<BuildRef,BBox3fa>
         {
           BBox3fa bounds = empty;
+          BuildRef childrefs[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
           void* childptrs[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
           const RTCBounds* cbounds[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
           for (size_t i=0; i<N; i++) {
             bounds.extend(children[i].second);
-            childptrs[i] = children[i].first;
+            childrefs[i] = children[i].first;
+            childptrs[i] = children[i].first.ptr;
             cbounds[i] = (const RTCBounds*)&children[i].second;
           }
           setNodeBounds(node,cbounds,(unsigned int)N,userPtr);
           setNodeChildren(node,childptrs, (unsigned int)N,userPtr);
-          return std::make_pair(node,bounds);
+          return std::make_pair(BuildRef(node,bvh->recordNode(node,childrefs,N)),bounds);
         },
         
         /* lambda function that creates BVH leaves */
-        [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<void*,BBox3fa>
+        [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<BuildRef,BBox3fa>
         {
-          const size_t id = morton_src[current.begin()].index;
-          const BBox3fa bounds = prims[id].bounds(); 
-          void* node = createLeaf((RTCThreadLocalAllocator)&alloc,prims_i+current.begin(),current.size(),userPtr);
-          return std::make_pair(node,bounds);
+          const size_t items = current.size();
+          dynamic_large_stack_array(RTCBuildPrimitive,leaf_prims,items,32*sizeof(RTCBuildPrimitive));
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<items; i++)
+          {
+            const size_t id = morton_src[current.begin()+i].index;
+            leaf_prims[i] = prims_i[id];
+            bounds.extend(prims[id].bounds());
+          }
+          void* node = createLeaf((RTCThreadLocalAllocator)&alloc,leaf_prims,items,userPtr);
+          return std::make_pair(BuildRef(node,bvh->recordLeaf(node,current.begin(),current.size())),bounds);
         },
         
         /* lambda that calculates the bounds for some primitive */
@@ -156,8 +328,12 @@ namespace embree
         morton_src.data(),morton_tmp.data(),primitiveCount,
         *arguments);
 
+      /* reorder the primitives such that leaves reference ranges of the primitive array for refitting */
+      sortMortonPrimitives(bvh,prims,primitiveCount);
+
+      bvh->refit_root = root.first.id;
       bvh->allocator.cleanup();
-      return root.first;
+      return root.first.ptr;
     }
 
     void* rtcBuildBVHBinnedSAH(const RTCBuildArguments* arguments)
@@ -188,7 +364,7 @@ namespace embree
       const PrimInfo pinfo(0,primitiveCount,bounds);
       
       /* build BVH */
-      void* root = BVHBuilderBinnedSAH::build<void*>(
+      BuildRef root = BVHBuilderBinnedSAH::build<BuildRef>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::CachedAllocator { 
@@ -206,14 +382,17 @@ namespace embree
         },
 
         /* lambda function that updates BVH nodes */
-        [&](const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, void* node, void** children, const size_t N) -> void* {
-          setNodeChildren(node,children, (unsigned int)N,userPtr);
-          return node;
+        [&](const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, void* node, BuildRef* children, const size_t N) -> BuildRef {
+          void* childptrs[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+          for (size_t i=0; i<N; i++) childptrs[i] = children[i].ptr;
+          setNodeChildren(node,childptrs, (unsigned int)N,userPtr);
+          return BuildRef(node,bvh->recordNode(node,children,N));
         },
         
         /* lambda function that creates BVH leaves */
-        [&](const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> void* {
-          return createLeaf((RTCThreadLocalAllocator)&alloc,(RTCBuildPrimitive*)(prims+range.begin()),range.size(),userPtr);
+        [&](const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> BuildRef {
+          void* node = createLeaf((RTCThreadLocalAllocator)&alloc,(RTCBuildPrimitive*)(prims+range.begin()),range.size(),userPtr);
+          return BuildRef(node,bvh->recordLeaf(node,range.begin(),range.size()));
         },
         
         /* progress monitor function */
@@ -226,8 +405,9 @@ namespace embree
         
         (PrimRef*)prims,pinfo,*arguments);
         
+      bvh->refit_root = root.id;
       bvh->allocator.cleanup();
-      return root;
+      return root.ptr;
     }
 
     void* rtcBuildBVHSpatialSAH(const RTCBuildArguments* arguments)
@@ -258,34 +438,8 @@ namespace embree
 
       const PrimInfo pinfo(0,primitiveCount,bounds);
 
-      /* function that splits a build primitive */
-      struct Splitter
-      {
-        Splitter (RTCSplitPrimitiveFunction splitPrimitive, unsigned geomID, unsigned primID, void* userPtr)
-          : splitPrimitive(splitPrimitive), geomID(geomID), primID(primID), userPtr(userPtr) {}
-        
-        __forceinline void operator() (PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const 
-        {
-          prim.geomIDref() &= BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK;
-          splitPrimitive((RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
-          left_o.geomIDref()  = geomID; left_o.primIDref()  = primID;
-          right_o.geomIDref() = geomID; right_o.primIDref() = primID;
-        }
-
-        __forceinline void operator() (const BBox3fa& box, const size_t dim, const float pos, BBox3fa& left_o, BBox3fa& right_o) const 
-        {
-          PrimRef prim(box,geomID & BVHBuilderBinnedFastSpatialSAH::GEOMID_MASK,primID);
-          splitPrimitive((RTCBuildPrimitive*)&prim,(unsigned)dim,pos,(RTCBounds*)&left_o,(RTCBounds*)&right_o,userPtr);
-        }
-   
-        RTCSplitPrimitiveFunction splitPrimitive;
-        unsigned geomID;
-        unsigned primID;
-        void* userPtr;
-      };
-
       /* build BVH */
-      void* root = BVHBuilderBinnedFastSpatialSAH::build<void*>(
+      BuildRef root = BVHBuilderBinnedFastSpatialSAH::build<BuildRef>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::CachedAllocator { 
@@ -303,19 +457,22 @@ namespace embree
         },
 
         /* lambda function that updates BVH nodes */
-        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& precord, const BVHBuilderBinnedFastSpatialSAH::BuildRecord* crecords, void* node, void** children, const size_t N) -> void* {
-          setNodeChildren(node,children, (unsigned int)N,userPtr);
-          return node;
+        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& precord, const BVHBuilderBinnedFastSpatialSAH::BuildRecord* crecords, void* node, BuildRef* children, const size_t N) -> BuildRef {
+          void* childptrs[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+          for (size_t i=0; i<N; i++) childptrs[i] = children[i].ptr;
+          setNodeChildren(node,childptrs, (unsigned int)N,userPtr);
+          return BuildRef(node,bvh->recordNode(node,children,N));
         },
         
         /* lambda function that creates BVH leaves */
-        [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> void* {
-          return createLeaf((RTCThreadLocalAllocator)&alloc,(RTCBuildPrimitive*)(prims+range.begin()),range.size(),userPtr);
+        [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> BuildRef {
+          void* node = createLeaf((RTCThreadLocalAllocator)&alloc,(RTCBuildPrimitive*)(prims+range.begin()),range.size(),userPtr);
+          return BuildRef(node,bvh->recordLeaf(node,range.begin(),range.size()));
         },
         
         /* returns the splitter */
-        [&] ( const PrimRef& prim ) -> Splitter {
-          return Splitter(splitPrimitive,prim.geomID(),prim.primID(),userPtr);
+        [&] ( const PrimRef& prim ) -> SpatialSplitter {
+          return SpatialSplitter(splitPrimitive,prim.geomID(),prim.primID(),userPtr);
         },
 
         /* progress monitor function */
@@ -330,8 +487,425 @@ namespace embree
         arguments->primitiveArrayCapacity,
         pinfo,*arguments);
         
+      bvh->refit_root = root.id;
+      bvh->allocator.cleanup();
+      return root.ptr;
+    }
+
+    void* rtcBuildBVHMortonFlat(const RTCBuildArguments* arguments)
+    {
+      BVH* bvh = (BVH*) arguments->bvh;
+      RTCBuildPrimitive* prims_i =  arguments->primitives;
+      size_t primitiveCount = arguments->primitiveCount;
+      RTCBuildNode* nodes = arguments->nodes;
+      RTCProgressMonitorFunction buildProgress = arguments->buildProgress;
+      void* userPtr = arguments->userPtr;
+        
+      std::atomic<size_t> progress(0);
+      std::atomic<size_t> nodeCount(1); // node 0 is reserved for the root
+      
+      /* initialize temporary arrays for morton builder */
+      PrimRef* prims = (PrimRef*) prims_i;
+      mvector<BVHBuilderMorton::BuildPrim>& morton_src = bvh->morton_src;
+      mvector<BVHBuilderMorton::BuildPrim>& morton_tmp = bvh->morton_tmp;
+      morton_src.resize(primitiveCount);
+      morton_tmp.resize(primitiveCount);
+
+      /* compute centroid bounds */
+      const BBox3fa centBounds = parallel_reduce ( size_t(0), primitiveCount, BBox3fa(empty), [&](const range<size_t>& r) -> BBox3fa {
+
+          BBox3fa bounds(empty);
+          for (size_t i=r.begin(); i<r.end(); i++) 
+            bounds.extend(prims[i].bounds().center2());
+          return bounds;
+        }, BBox3fa::merge);
+      
+      /* compute morton codes */
+      BVHBuilderMorton::MortonCodeMapping mapping(centBounds);
+      parallel_for ( size_t(0), primitiveCount, [&](const range<size_t>& r) {
+          BVHBuilderMorton::MortonCodeGenerator generator(mapping,&morton_src[r.begin()]);
+          for (size_t i=r.begin(); i<r.end(); i++) {
+            generator(prims[i].bounds(),(unsigned) i);
+          }
+        });
+
+      /* start morton build */
+      std::pair<FlatRef,BBox3fa> root = BVHBuilderMorton::build<std::pair<FlatRef,BBox3fa>>(
+        
+        /* thread local allocator for fast allocations */
+        [&] () -> FastAllocator::CachedAllocator { 
+          return bvh->allocator.getCachedAllocator();
+        },
+        
+        /* lambda function that allocates consecutive nodes for all children */
+        [&] ( const FastAllocator::CachedAllocator& alloc, size_t N ) -> unsigned int {
+          return (unsigned int) nodeCount.fetch_add(N);
+        },
+        
+        /* lambda function that sets the children */
+        [&] (unsigned int offset, const std::pair<FlatRef,BBox3fa>* children, size_t N) -> std::pair<FlatRef,BBox3fa>
+        {
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<N; i++) {
+            bounds.extend(children[i].second);
+            setFlatNode(nodes[offset+i],children[i].second);
+            setFlatNode(nodes[offset+i],children[i].first);
+          }
+          return std::make_pair(FlatRef(offset,(unsigned int)N),bounds);
+        },
+        
+        /* lambda function that creates BVH leaves */
+        [&]( const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> std::pair<FlatRef,BBox3fa>
+        {
+          BBox3fa bounds = empty;
+          for (size_t i=current.begin(); i<current.end(); i++)
+            bounds.extend(prims[morton_src[i].index].bounds());
+          return std::make_pair(FlatRef(current.begin(),current.size() | RTC_BUILD_NODE_LEAF),bounds);
+        },
+        
+        /* lambda that calculates the bounds for some primitive */
+        [&] (const BVHBuilderMorton::BuildPrim& morton) -> BBox3fa {
+          return prims[morton.index].bounds();
+        },
+        
+        /* progress monitor function */
+        [&] (size_t dn) {
+          if (!buildProgress) return true;
+          const size_t n = progress.fetch_add(dn)+dn;
+          const double f = std::min(1.0,double(n)/double(primitiveCount));
+          return buildProgress(userPtr,f);
+        },
+        
+        morton_src.data(),morton_tmp.data(),primitiveCount,
+        *arguments);
+
+      setFlatNode(nodes[0],root.second);
+      setFlatNode(nodes[0],root.first);
+
+      /* reorder the primitives such that leaves reference ranges of the primitive array */
+      sortMortonPrimitives(bvh,prims,primitiveCount);
+
+      bvh->node_count = nodeCount;
       bvh->allocator.cleanup();
-      return root;
+      return nodes;
+    }
+
+    void* rtcBuildBVHBinnedSAHFlat(const RTCBuildArguments* arguments)
+    {
+      BVH* bvh = (BVH*) arguments->bvh;
+      RTCBuildPrimitive* prims =  arguments->primitives;
+      size_t primitiveCount = arguments->primitiveCount;
+      RTCBuildNode* nodes = arguments->nodes;
+      RTCProgressMonitorFunction buildProgress = arguments->buildProgress;
+      void* userPtr = arguments->userPtr;
+      
+      std::atomic<size_t> progress(0);
+      std::atomic<size_t> nodeCount(1); // node 0 is reserved for the root
+  
+      /* calculate priminfo */
+      auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
+        {
+          CentGeomBBox3fa bounds(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+            bounds.extend((BBox3fa&)prims[j]);
+          return bounds;
+        };
+      const CentGeomBBox3fa bounds = 
+        parallel_reduce(size_t(0),primitiveCount,size_t(1024),size_t(1024),CentGeomBBox3fa(empty), computeBounds, CentGeomBBox3fa::merge2);
+
+      const PrimInfo pinfo(0,primitiveCount,bounds);
+      
+      /* build BVH */
+      FlatRef root = BVHBuilderBinnedSAH::build<FlatRef>(
+        
+        /* thread local allocator for fast allocations */
+        [&] () -> FastAllocator::CachedAllocator { 
+          return bvh->allocator.getCachedAllocator();
+        },
+
+        /* lambda function that allocates consecutive nodes for all children */
+        [&](BVHBuilderBinnedSAH::BuildRecord* children, const size_t N, const FastAllocator::CachedAllocator& alloc) -> unsigned int
+        {
+          const unsigned int offset = (unsigned int) nodeCount.fetch_add(N);
+          for (size_t i=0; i<N; i++) setFlatNode(nodes[offset+i],children[i].prims.geomBounds);
+          return offset;
+        },
+
+        /* lambda function that sets the children */
+        [&](const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, unsigned int offset, FlatRef* children, const size_t N) -> FlatRef {
+          for (size_t i=0; i<N; i++) setFlatNode(nodes[offset+i],children[i]);
+          return FlatRef(offset,(unsigned int)N);
+        },
+        
+        /* lambda function that creates BVH leaves */
+        [&](const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> FlatRef {
+          return FlatRef((unsigned int)range.begin(),(unsigned int)range.size() | RTC_BUILD_NODE_LEAF);
+        },
+        
+        /* progress monitor function */
+        [&] (size_t dn) {
+          if (!buildProgress) return true;
+          const size_t n = progress.fetch_add(dn)+dn;
+          const double f = std::min(1.0,double(n)/double(primitiveCount));
+          return buildProgress(userPtr,f);
+        },
+        
+        (PrimRef*)prims,pinfo,*arguments);
+
+      setFlatNode(nodes[0],pinfo.geomBounds);
+      setFlatNode(nodes[0],root);
+        
+      bvh->node_count = nodeCount;
+      bvh->allocator.cleanup();
+      return nodes;
+    }
+
+    void* rtcBuildBVHSpatialSAHFlat(const RTCBuildArguments* arguments)
+    {
+      BVH* bvh = (BVH*) arguments->bvh;
+      RTCBuildPrimitive* prims =  arguments->primitives;
+      size_t primitiveCount = arguments->primitiveCount;
+      RTCBuildNode* nodes = arguments->nodes;
+      RTCSplitPrimitiveFunction splitPrimitive = arguments->splitPrimitive;
+      RTCProgressMonitorFunction buildProgress = arguments->buildProgress;
+      void* userPtr = arguments->userPtr;
+      
+      std::atomic<size_t> progress(0);
+      std::atomic<size_t> nodeCount(1); // node 0 is reserved for the root
+  
+      /* calculate priminfo */
+      auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
+        {
+          CentGeomBBox3fa bounds(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+            bounds.extend((BBox3fa&)prims[j]);
+          return bounds;
+        };
+      const CentGeomBBox3fa bounds = 
+        parallel_reduce(size_t(0),primitiveCount,size_t(1024),size_t(1024),CentGeomBBox3fa(empty), computeBounds, CentGeomBBox3fa::merge2);
+
+      const PrimInfo pinfo(0,primitiveCount,bounds);
+
+      /* build BVH */
+      FlatRef root = BVHBuilderBinnedFastSpatialSAH::build<FlatRef>(
+        
+        /* thread local allocator for fast allocations */
+        [&] () -> FastAllocator::CachedAllocator { 
+          return bvh->allocator.getCachedAllocator();
+        },
+
+        /* lambda function that allocates consecutive nodes for all children */
+        [&] (BVHBuilderBinnedFastSpatialSAH::BuildRecord* children, const size_t N, const FastAllocator::CachedAllocator& alloc) -> unsigned int
+        {
+          const unsigned int offset = (unsigned int) nodeCount.fetch_add(N);
+          for (size_t i=0; i<N; i++) setFlatNode(nodes[offset+i],children[i].prims.geomBounds);
+          return offset;
+        },
+
+        /* lambda function that sets the children */
+        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& precord, const BVHBuilderBinnedFastSpatialSAH::BuildRecord* crecords, unsigned int offset, FlatRef* children, const size_t N) -> FlatRef {
+          for (size_t i=0; i<N; i++) setFlatNode(nodes[offset+i],children[i]);
+          return FlatRef(offset,(unsigned int)N);
+        },
+        
+        /* lambda function that creates BVH leaves */
+        [&] (const PrimRef* prims, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> FlatRef {
+          return FlatRef((unsigned int)range.begin(),(unsigned int)range.size() | RTC_BUILD_NODE_LEAF);
+        },
+        
+        /* returns the splitter */
+        [&] ( const PrimRef& prim ) -> SpatialSplitter {
+          return SpatialSplitter(splitPrimitive,prim.geomID(),prim.primID(),userPtr);
+        },
+
+        /* progress monitor function */
+        [&] (size_t dn) {
+          if (!buildProgress) return true;
+          const size_t n = progress.fetch_add(dn)+dn;
+          const double f = std::min(1.0,double(n)/double(primitiveCount));
+          return buildProgress(userPtr,f);
+        },
+        
+        (PrimRef*)prims,
+        arguments->primitiveArrayCapacity,
+        pinfo,*arguments);
+
+      setFlatNode(nodes[0],pinfo.geomBounds);
+      setFlatNode(nodes[0],root);
+        
+      bvh->node_count = nodeCount;
+      bvh->allocator.cleanup();
+      return nodes;
+    }
+
+    void* rtcBuildBVHMBlur(const RTCBuildArguments* arguments)
+    {
+      typedef BVHNodeRecordMB4D<void*> NodeRecordMB4D;
+
+      BVH* bvh = (BVH*) arguments->bvh;
+      const RTCBuildPrimitiveMB* prims_i = arguments->primitivesMB;
+      size_t primitiveCount = arguments->primitiveCount;
+      RTCCreateNodeFunction createNode = arguments->createNode;
+      RTCSetNodeChildMBFunction setNodeChildMB = arguments->setNodeChildMB;
+      RTCCreateLeafMBFunction createLeafMB = arguments->createLeafMB;
+      RTCProgressMonitorFunction buildProgress = arguments->buildProgress;
+      void* userPtr = arguments->userPtr;
+
+      std::atomic<size_t> progress(0);
+      const RecalculateBuildPrimitiveMB recalculatePrimRef(prims_i,arguments->primitiveLinearBounds,userPtr);
+
+      /* create primrefs that reference the build primitives by index */
+      mvector<PrimRefMB> prims(bvh->device,primitiveCount);
+      auto computePrimInfo = [&](const range<size_t>& r) -> PrimInfoMB
+        {
+          PrimInfoMB pinfo(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+          {
+            const unsigned num_time_segments = max(prims_i[j].timeSegmentCount,1u);
+            prims[j] = PrimRefMB(recalculatePrimRef.linearBounds(prims_i[j],BBox1f(0.0f,1.0f)),num_time_segments,num_time_segments,j);
+            pinfo.add_primref(prims[j]);
+          }
+          return pinfo;
+        };
+      PrimInfoMB pinfo =
+        parallel_reduce(size_t(0),primitiveCount,size_t(1024),size_t(1024),PrimInfoMB(empty), computePrimInfo, PrimInfoMB::merge2);
+      pinfo.object_range = range<size_t>(0,primitiveCount);
+      pinfo.time_range = BBox1f(0.0f,1.0f);
+
+      /* settings for BVH build */
+      BVHBuilderMSMBlur::Settings settings;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),maxBranchingFactor)) settings.branchingFactor = arguments->maxBranchingFactor;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),maxDepth          )) settings.maxDepth        = arguments->maxDepth;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),sahBlockSize      )) settings.logBlockSize    = bsr(arguments->sahBlockSize);
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),minLeafSize       )) settings.minLeafSize     = arguments->minLeafSize;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),maxLeafSize       )) settings.maxLeafSize     = arguments->maxLeafSize;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),traversalCost     )) settings.travCost        = arguments->traversalCost;
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),intersectionCost  )) settings.intCost         = arguments->intersectionCost;
+      const unsigned int branchingFactor = (unsigned int) settings.branchingFactor;
+
+      /* build BVH */
+      NodeRecordMB4D root = BVHBuilderMSMBlur::build<void*>(
+        prims,pinfo,bvh->device,recalculatePrimRef,
+
+        /* thread local allocator for fast allocations */
+        [&] () -> FastAllocator::CachedAllocator { 
+          return bvh->allocator.getCachedAllocator();
+        },
+
+        /* lambda function that creates BVH nodes, the number of children is not known yet */
+        [&] (const FastAllocator::CachedAllocator& alloc, bool hasTimeSplits) -> void* {
+          return createNode((RTCThreadLocalAllocator)&alloc,branchingFactor,userPtr);
+        },
+
+        /* lambda function that sets a child of a BVH node */
+        [&] (void* node, size_t i, const NodeRecordMB4D& child) {
+          setNodeChildMB(node,(unsigned int)i,child.ref,(const RTCLinearBounds*)&child.lbounds,child.dt.lower,child.dt.upper,userPtr);
+        },
+
+        /* lambda function that creates BVH leaves for the time range of the build record */
+        [&] (const BVHBuilderMSMBlur::BuildRecord& current, const FastAllocator::CachedAllocator& alloc) -> NodeRecordMB4D
+        {
+          const SetMB& set = current.prims;
+          const size_t items = set.size();
+          dynamic_large_stack_array(RTCBuildPrimitiveMB,leaf_prims,items,32*sizeof(RTCBuildPrimitiveMB));
+          LBBox3fa lbounds = empty;
+          for (size_t i=0; i<items; i++)
+          {
+            const RTCBuildPrimitiveMB& prim = prims_i[(*set.prims)[set.object_range.begin()+i].ID()];
+            const LBBox3fa bounds = recalculatePrimRef.linearBounds(prim,set.time_range);
+            leaf_prims[i] = prim;
+            (LBBox3fa&) leaf_prims[i].bounds = bounds;
+            lbounds.extend(bounds);
+          }
+          void* node = createLeafMB((RTCThreadLocalAllocator)&alloc,leaf_prims,items,set.time_range.lower,set.time_range.upper,userPtr);
+          return NodeRecordMB4D(node,lbounds,set.time_range);
+        },
+
+        /* progress monitor function */
+        [&] (size_t dn) {
+          if (!buildProgress) return true;
+          const size_t n = progress.fetch_add(dn)+dn;
+          const double f = std::min(1.0,double(n)/double(primitiveCount));
+          return buildProgress(userPtr,f);
+        },
+
+        settings);
+
+      bvh->allocator.cleanup();
+      return root.ref;
+    }
+
+    BBox3fa rtcRefitBVHNode(BVH* bvh, unsigned int id, const RTCBuildPrimitive* prims, RTCSetNodeBoundsFunction setNodeBounds, void* userPtr)
+    {
+      const RefitNode& node = bvh->refit_nodes[id];
+
+      /* leaves get bounded by their primitives */
+      if (node.child == RefitNode::INVALID)
+      {
+        BBox3fa bounds = empty;
+        for (size_t i=node.begin; i<node.begin+node.size; i++)
+          bounds.extend((const BBox3fa&)prims[i]);
+        return bounds;
+      }
+
+      unsigned int children[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+      size_t N = 0;
+      for (unsigned int c=node.child; c!=RefitNode::INVALID; c=bvh->refit_nodes[c].next)
+        children[N++] = c;
+
+      /* refit large subtrees in parallel */
+      BBox3fa cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+      if (node.size > 1024)
+      {
+        parallel_for(size_t(0), N, [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              cbounds[i] = rtcRefitBVHNode(bvh,children[i],prims,setNodeBounds,userPtr);
+          });
+      }
+      else
+      {
+        for (size_t i=0; i<N; i++)
+          cbounds[i] = rtcRefitBVHNode(bvh,children[i],prims,setNodeBounds,userPtr);
+      }
+
+      BBox3fa bounds = empty;
+      const RTCBounds* pbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+      for (size_t i=0; i<N; i++) {
+        bounds.extend(cbounds[i]);
+        pbounds[i] = (const RTCBounds*) &cbounds[i];
+      }
+      setNodeBounds(node.ptr,pbounds,(unsigned int)N,userPtr);
+      return bounds;
+    }
+
+    RTC_API size_t rtcGetBVHNodeCount(RTCBVH hbvh)
+    {
+      BVH* bvh = (BVH*) hbvh;
+      Device* device = bvh ? bvh->device : nullptr;
+      RTC_CATCH_BEGIN;
+      RTC_TRACE(rtcGetBVHNodeCount);
+      RTC_VERIFY_HANDLE(hbvh);
+      return bvh->node_count;
+      RTC_CATCH_END(device);
+      return 0;
+    }
+
+    RTC_API void rtcRefitBVH(RTCBVH hbvh, const RTCBuildPrimitive* primitives, RTCSetNodeBoundsFunction setNodeBounds, void* userPtr)
+    {
+      BVH* bvh = (BVH*) hbvh;
+      RTC_CATCH_BEGIN;
+      RTC_TRACE(rtcRefitBVH);
+      RTC_VERIFY_HANDLE(hbvh);
+      RTC_VERIFY_HANDLE(setNodeBounds);
+
+      if (bvh->refit_root == RefitNode::INVALID)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH was not built with RTC_BUILD_FLAG_REFIT");
+
+      if (primitives == nullptr)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid primitives array");
+
+      rtcRefitBVHNode(bvh,bvh->refit_root,primitives,setNodeBounds,userPtr);
+      RTC_CATCH_END(bvh->device);
     }
 
     RTC_API void* rtcBuildBVH(const RTCBuildArguments* arguments)
@@ -341,10 +915,47 @@ namespace embree
       RTC_TRACE(rtcBuildBVH);
       RTC_VERIFY_HANDLE(bvh);
       RTC_VERIFY_HANDLE(arguments);
-      RTC_VERIFY_HANDLE(arguments->createNode);
-      RTC_VERIFY_HANDLE(arguments->setNodeChildren);
-      RTC_VERIFY_HANDLE(arguments->setNodeBounds);
-      RTC_VERIFY_HANDLE(arguments->createLeaf);
+
+      /* the previously recorded topology gets invalid */
+      bvh->refit_nodes.clear();
+      bvh->refit_count = 0;
+      bvh->refit_root = RefitNode::INVALID;
+      bvh->node_count = 0;
+
+      const bool refit = arguments->buildFlags & RTC_BUILD_FLAG_REFIT;
+      const bool flat = RTC_BUILD_ARGUMENTS_HAS((*arguments),nodes) && arguments->nodes;
+
+      /* motion blur build */
+      if (RTC_BUILD_ARGUMENTS_HAS((*arguments),primitivesMB) && arguments->primitivesMB)
+      {
+        RTC_VERIFY_HANDLE(arguments->createNode);
+        RTC_VERIFY_HANDLE(arguments->setNodeChildMB);
+        RTC_VERIFY_HANDLE(arguments->createLeafMB);
+
+        if (refit || flat)
+          throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"refitting and flat nodes are not supported for motion blur builds");
+
+        bvh->allocator.init_estimate(arguments->primitiveCount*sizeof(LBBox3fa));
+        bvh->allocator.reset();
+        return rtcBuildBVHMBlur(arguments);
+      }
+
+      /* flat builds write nodes without invoking callbacks */
+      if (flat)
+      {
+        if (refit)
+          throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"refitting is not supported for flat node builds");
+
+        if (arguments->nodeArrayCapacity < max(2*arguments->primitiveCount,size_t(1)))
+          throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"nodeArrayCapacity must be at least twice the primitiveCount");
+      }
+      else
+      {
+        RTC_VERIFY_HANDLE(arguments->createNode);
+        RTC_VERIFY_HANDLE(arguments->setNodeChildren);
+        RTC_VERIFY_HANDLE(arguments->setNodeBounds);
+        RTC_VERIFY_HANDLE(arguments->createLeaf);
+      }
 
       if (arguments->primitiveArrayCapacity < arguments->primitiveCount)
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"primitiveArrayCapacity must be greater or equal to primitiveCount")
@@ -353,16 +964,24 @@ namespace embree
       bvh->allocator.init_estimate(arguments->primitiveCount*sizeof(BBox3fa));
       bvh->allocator.reset();
 
+      /* a BVH has at most two nodes per primitive, as spatial splits are disabled for refitting */
+      if (refit)
+        bvh->refit_nodes.resize(2*arguments->primitiveCount+1);
+
+      /* spatial splits require a node array large enough for all split primitives */
+      const bool spatial = arguments->splitPrimitive != nullptr && arguments->primitiveArrayCapacity > arguments->primitiveCount && !refit &&
+        (!flat || arguments->nodeArrayCapacity >= 2*arguments->primitiveArrayCapacity);
+
       /* switch between differnet builders based on quality level */
       if (arguments->buildQuality == RTC_BUILD_QUALITY_LOW)
-        return rtcBuildBVHMorton(arguments);
+        return flat ? rtcBuildBVHMortonFlat(arguments) : rtcBuildBVHMorton(arguments);
       else if (arguments->buildQuality == RTC_BUILD_QUALITY_MEDIUM)
-        return rtcBuildBVHBinnedSAH(arguments);
+        return flat ? rtcBuildBVHBinnedSAHFlat(arguments) : rtcBuildBVHBinnedSAH(arguments);
       else if (arguments->buildQuality == RTC_BUILD_QUALITY_HIGH) {
-        if (arguments->splitPrimitive == nullptr || arguments->primitiveArrayCapacity <= arguments->primitiveCount)
-          return rtcBuildBVHBinnedSAH(arguments);
+        if (!spatial)
+          return flat ? rtcBuildBVHBinnedSAHFlat(arguments) : rtcBuildBVHBinnedSAH(arguments);
         else
-          return rtcBuildBVHSpatialSAH(arguments);
+          return flat ? rtcBuildBVHSpatialSAHFlat(arguments) : rtcBuildBVHSpatialSAH(arguments);
       }
       else
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid build quality");
@@ -15,9 +15,13 @@
 // ======================================================================== //
 
 #include "scene.h"
+#include "serialize.h"
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+
+#include <fstream>
+#include <tuple>
  
 namespace embree
 {
@@ -34,7 +38,8 @@ namespace embree
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
-      is_build(false), modified(true),
+      is_build(false), modified(true), accel_stream(nullptr),
+      commitThread(nullptr), commit_callback(nullptr), commit_callback_ptr(nullptr),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
       numIntersectionFiltersN(0)
   {
@@ -59,6 +64,8 @@ namespace embree
 
   Scene::~Scene () 
   {
+    waitForCommitAsync();
+
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
     delete group; group = nullptr;
 #endif
@@ -122,7 +129,16 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     if (device->tri_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (quality_flags != RTC_BUILD_QUALITY_LOW && isQuantizedAccel())
+      {
+#if defined (EMBREE_TARGET_SIMD8)
+        if (device->hasISA(AVX))
+          accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
+        else
+#endif
+          accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+      }
+      else if (quality_flags != RTC_BUILD_QUALITY_LOW)
       {
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
         switch (mode) {
@@ -243,7 +259,16 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_QUAD)
     if (device->quad_accel == "default") 
     {
-      if (quality_flags != RTC_BUILD_QUALITY_LOW)
+      if (quality_flags != RTC_BUILD_QUALITY_LOW && isQuantizedAccel())
+      {
+#if defined (EMBREE_TARGET_SIMD8)
+        if (device->hasISA(AVX))
+          accels_add(device->bvh8_factory->BVH8QuantizedQuad4i(this));
+        else
+#endif
+          accels_add(device->bvh4_factory->BVH4QuantizedQuad4i(this));
+      }
+      else if (quality_flags != RTC_BUILD_QUALITY_LOW)
       {
         /* static */
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
@@ -443,7 +468,16 @@ namespace embree
   void Scene::createUserGeometryAccel()
   {
 #if defined(EMBREE_GEOMETRY_USER)
-    if (device->object_accel == "default") 
+    if (device->object_accel == "default" && isQuantizedAccel())
+    {
+#if defined (EMBREE_TARGET_SIMD8)
+      if (device->hasISA(AVX))
+        accels_add(device->bvh8_factory->BVH8QuantizedUserGeometry(this));
+      else
+#endif
+        accels_add(device->bvh4_factory->BVH4QuantizedUserGeometry(this));
+    }
+    else if (device->object_accel == "default") 
     {
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->hasISA(AVX) && !isCompactAccel())
@@ -465,8 +499,10 @@ namespace embree
       }
     }
     else if (device->object_accel == "bvh4.object") accels_add(device->bvh4_factory->BVH4UserGeometry(this));
+    else if (device->object_accel == "qbvh4.object") accels_add(device->bvh4_factory->BVH4QuantizedUserGeometry(this));
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->object_accel == "bvh8.object") accels_add(device->bvh8_factory->BVH8UserGeometry(this));
+    else if (device->object_accel == "qbvh8.object") accels_add(device->bvh8_factory->BVH8QuantizedUserGeometry(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown user geometry accel "+device->object_accel);
 #endif
@@ -495,6 +531,16 @@ namespace embree
   {
 #if defined(EMBREE_GEOMETRY_INSTANCE)
     //if (device->object_accel == "default") 
+    if (isQuantizedAccel())
+    {
+#if defined (EMBREE_TARGET_SIMD8)
+      if (device->hasISA(AVX))
+        accels_add(device->bvh8_factory->BVH8QuantizedInstance(this));
+      else
+#endif
+        accels_add(device->bvh4_factory->BVH4QuantizedInstance(this));
+    }
+    else
     {
 #if defined (EMBREE_TARGET_SIMD8)
       if (device->hasISA(AVX) && !isCompactAccel())
@@ -657,8 +703,9 @@ namespace embree
     /* select fast code path if no filter function is present */
     accels_select(hasFilterFunction());
   
-    /* build all hierarchies of this scene */
-    accels_build();
+    /* build all hierarchies of this scene, or load them from a file */
+    if (accel_stream) accels_load(*accel_stream);
+    else              accels_build();
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
@@ -684,6 +731,209 @@ namespace embree
     setModified(false);
   }
 
+  static const char* accelFileMagic = "embree_bvh";
+  static const unsigned int accelFileVersion = 1;
+
+  std::vector<unsigned int> Scene::getFileSignature() const
+  {
+    std::vector<unsigned int> signature;
+    signature.push_back(accelFileVersion);
+    signature.push_back(RTC_VERSION);
+    signature.push_back((unsigned int)sizeof(void*));
+    signature.push_back((unsigned int)device->enabled_cpu_features);
+    signature.push_back((unsigned int)scene_flags);
+    signature.push_back((unsigned int)quality_flags);
+    signature.push_back((unsigned int)geometries.size());
+    for (size_t i=0; i<geometries.size(); i++)
+    {
+      const Geometry* geom = geometries[i].ptr;
+      signature.push_back(geom ? (unsigned int)geom->getTypeMask() : 0);
+      signature.push_back(geom ? (unsigned int)geom->isEnabled() : 0);
+      signature.push_back(geom ? (unsigned int)geom->size() : 0);
+      signature.push_back(geom ? geom->numTimeSteps : 0);
+    }
+    return signature;
+  }
+
+  void Scene::save(const std::string& fileName)
+  {
+    if (isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+
+    std::ofstream stream(fileName.c_str(),std::ios::binary);
+    if (!stream)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot open file " + fileName);
+
+    const std::vector<unsigned int> signature = getFileSignature();
+    writeString(stream,accelFileMagic);
+    writeBinary(stream,signature.size());
+    writeBytes(stream,signature.data(),signature.size()*sizeof(unsigned int));
+    accels_save(stream);
+  }
+
+  void Scene::load(const std::string& fileName)
+  {
+    std::ifstream stream(fileName.c_str(),std::ios::binary);
+    if (!stream)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"cannot open file " + fileName);
+
+    if (readString(stream) != accelFileMagic)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid acceleration structure file " + fileName);
+
+    /* the file is only valid for the same library, ISA, scene configuration, and geometries */
+    const std::vector<unsigned int> signature = getFileSignature();
+    std::vector<unsigned int> fileSignature(readBinary<size_t>(stream) == signature.size() ? signature.size() : 0);
+    if (fileSignature.size()) readBytes(stream,fileSignature.data(),fileSignature.size()*sizeof(unsigned int));
+    if (fileSignature != signature)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure file does not match scene");
+
+    accel_stream = &stream;
+    setModified();
+    try {
+      commit(false);
+    }
+    catch (...) {
+      accel_stream = nullptr;
+      throw;
+    }
+    accel_stream = nullptr;
+  }
+
+  bool Scene::pointQuery(RTCPointQuery* query, RTCPointQueryFunction func, void* userPtr)
+  {
+    if (isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+
+    PointQueryContext context(this,func,userPtr);
+    return accels_pointQuery(query,&context);
+  }
+
+  namespace
+  {
+    struct ClosestPointQuery
+    {
+      Scene* scene;
+      RTCClosestPoint* result;
+    };
+
+    template<typename Mesh>
+    __forceinline Vec3fa closestPointVertex(const Mesh* mesh, unsigned int v, float time)
+    {
+      if (mesh->numTimeSteps == 1)
+        return mesh->vertex(v);
+
+      float ftime; const int itime = getTimeSegment(time, mesh->fnumTimeSegments, ftime);
+      return lerp(mesh->vertex(v,itime+0),mesh->vertex(v,itime+1),ftime);
+    }
+
+    bool closestPointFunc(RTCPointQueryFunctionArguments* args)
+    {
+      ClosestPointQuery* data = (ClosestPointQuery*) args->userPtr;
+      RTCPointQuery* query = args->query;
+      const Geometry* geometry = data->scene->get(args->geomID);
+      const Vec3fa p(query->x,query->y,query->z);
+      const float time = query->time;
+
+      Vec3fa q; float u, v;
+      if (geometry->getType() == Geometry::GTY_TRIANGLE_MESH)
+      {
+        const TriangleMesh* mesh = (const TriangleMesh*) geometry;
+        const TriangleMesh::Triangle& tri = mesh->triangle(args->primID);
+        const Vec3fa v0 = closestPointVertex(mesh,tri.v[0],time);
+        const Vec3fa v1 = closestPointVertex(mesh,tri.v[1],time);
+        const Vec3fa v2 = closestPointVertex(mesh,tri.v[2],time);
+        q = closestPointTriangle(p,v0,v1,v2,u,v);
+      }
+      else if (geometry->getType() == Geometry::GTY_QUAD_MESH)
+      {
+        /* quads are split into the triangles (v0,v1,v3) and (v2,v3,v1) like in the intersectors */
+        const QuadMesh* mesh = (const QuadMesh*) geometry;
+        const QuadMesh::Quad& quad = mesh->quad(args->primID);
+        const Vec3fa v0 = closestPointVertex(mesh,quad.v[0],time);
+        const Vec3fa v1 = closestPointVertex(mesh,quad.v[1],time);
+        const Vec3fa v2 = closestPointVertex(mesh,quad.v[2],time);
+        const Vec3fa v3 = closestPointVertex(mesh,quad.v[3],time);
+        float u1, v1_;
+        q = closestPointTriangle(p,v0,v1,v3,u,v);
+        const Vec3fa q1 = closestPointTriangle(p,v2,v3,v1,u1,v1_);
+        if (dot(q1-p,q1-p) < dot(q-p,q-p)) {
+          q = q1; u = 1.0f-u1; v = 1.0f-v1_;
+        }
+      }
+      else
+        return false;
+
+      const float d = length(q-p);
+      if (d >= query->radius)
+        return false;
+
+      query->radius = d;
+      data->result->p_x = q.x;
+      data->result->p_y = q.y;
+      data->result->p_z = q.z;
+      data->result->u = u;
+      data->result->v = v;
+      data->result->primID = args->primID;
+      data->result->geomID = args->geomID;
+      return true;
+    }
+  }
+
+  bool Scene::closestPoint(RTCPointQuery* query, RTCClosestPoint* result)
+  {
+    result->primID = RTC_INVALID_GEOMETRY_ID;
+    result->geomID = RTC_INVALID_GEOMETRY_ID;
+    ClosestPointQuery data = { this, result };
+    return pointQuery(query,closestPointFunc,&data);
+  }
+
+  void Scene::collide(Scene* other, RTCCollideFunction func, void* userPtr)
+  {
+    if (isModified() || other->isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+
+    /* the collider only knows the bounds of triangles, quads, and user geometries */
+    auto supported = [] (const GeometryCounts& counts) {
+      return counts.numBezierCurves == 0 && counts.numLineSegments == 0 && counts.numSubdivPatches == 0 && counts.numInstances == 0 && counts.numGrids == 0;
+    };
+    if (!supported(world) || !supported(worldMB) || !supported(other->world) || !supported(other->worldMB))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collisions are only supported for triangle meshes, quad meshes, and user geometries");
+
+    /* spatial split BVHs reference primitives from multiple leaves, thus pairs can be found multiple times */
+    auto spatialSplits = [] (const Scene* scene) {
+      return scene->quality_flags == RTC_BUILD_QUALITY_HIGH ||
+        scene->device->tri_builder == "sah_fast_spatial" || scene->device->quad_builder == "sah_fast_spatial";
+    };
+    if (!spatialSplits(this) && !spatialSplits(other))
+    {
+      CollideContext context(this,other,func,userPtr);
+      accels_collide(other,&context);
+      return;
+    }
+
+    /* gather all pairs, and report each of them once after the traversal */
+    struct Collisions {
+      MutexSys mutex;
+      std::vector<RTCCollision> pairs;
+    } collisions;
+    
+    auto gather = [] (void* ptr, RTCCollision* pairs, unsigned int num) {
+      Collisions* collisions = (Collisions*) ptr;
+      Lock<MutexSys> lock(collisions->mutex);
+      collisions->pairs.insert(collisions->pairs.end(),pairs,pairs+num);
+    };
+    CollideContext context(this,other,gather,&collisions);
+    accels_collide(other,&context);
+
+    std::vector<RTCCollision>& pairs = collisions.pairs;
+    auto key = [] (const RTCCollision& c) { return std::make_tuple(c.geomID0,c.primID0,c.geomID1,c.primID1); };
+    std::sort(pairs.begin(),pairs.end(),[&] (const RTCCollision& a, const RTCCollision& b) { return key(a) < key(b); });
+    pairs.erase(std::unique(pairs.begin(),pairs.end(),[&] (const RTCCollision& a, const RTCCollision& b) { return key(a) == key(b); }),pairs.end());
+    
+    for (size_t i=0; i<pairs.size(); i+=CollisionBuffer::maxCollisions)
+      func(userPtr,pairs.data()+i,(unsigned int)min(pairs.size()-i,CollisionBuffer::maxCollisions));
+  }
+
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
   {
     if (quality_flags == quality_flags_i) return;
@@ -845,6 +1095,69 @@ namespace embree
   }
 #endif
 
+  /*! scene whose asynchronous commit the current thread is executing */
+  static __thread Scene* g_commit_async_scene = nullptr;
+
+  /* The asynchronous commit runs in its own thread, as the internal task
+   * scheduler only executes task trees rooted in a thread that waits for
+   * them. The commit thread becomes that root thread, and the parallel
+   * build work itself runs on the shared worker threads of the scheduler. */
+  static void commitThreadFunc(void* ptr)
+  {
+    Scene* scene = (Scene*) ptr;
+    g_commit_async_scene = scene;
+    RTCError error = RTC_ERROR_NONE;
+    try {
+      scene->commit(false);
+    } catch (std::bad_alloc&) {
+      Device::process_error(scene->device,error = RTC_ERROR_OUT_OF_MEMORY,"out of memory");
+    } catch (rtcore_error& e) {
+      Device::process_error(scene->device,error = e.error,e.what());
+    } catch (std::exception& e) {
+      Device::process_error(scene->device,error = RTC_ERROR_UNKNOWN,e.what());
+    } catch (...) {
+      Device::process_error(scene->device,error = RTC_ERROR_UNKNOWN,"unknown exception caught");
+    }
+
+    if (scene->commit_callback)
+      scene->commit_callback(scene->commit_callback_ptr,error);
+  }
+
+  void Scene::commitAsync(RTCCommitSceneFunction callback, void* userPtr)
+  {
+    Lock<MutexSys> lock(commitThreadMutex);
+
+    /* only one asynchronous commit can be in flight */
+    joinCommitThread();
+
+    commit_callback = callback;
+    commit_callback_ptr = userPtr;
+    commitThread = createThread(commitThreadFunc,this);
+  }
+
+  bool Scene::waitForCommitAsync()
+  {
+    Lock<MutexSys> lock(commitThreadMutex);
+    return joinCommitThread();
+  }
+
+  bool Scene::joinCommitThread()
+  {
+    if (!commitThread)
+      return false;
+
+    /* inside the completion callback the commit already finished, and the thread cannot join itself */
+    if (g_commit_async_scene == this) {
+      detach(commitThread);
+      g_commit_async_scene = nullptr;
+    }
+    else
+      join(commitThread);
+
+    commitThread = nullptr;
+    return true;
+  }
+
   void Scene::setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr) 
   {
     progress_monitor_function = func;
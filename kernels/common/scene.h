@@ -177,6 +177,35 @@ namespace embree
     
     void commit (bool join);
     void commit_task ();
+
+    /*! commits the scene in a separate thread and invokes the callback when finished */
+    void commitAsync (RTCCommitSceneFunction callback, void* userPtr);
+
+    /*! waits for an asynchronous commit to finish, returns false if none was pending */
+    bool waitForCommitAsync ();
+
+  private:
+    /*! joins the thread of a pending asynchronous commit, requires commitThreadMutex to be locked */
+    bool joinCommitThread ();
+
+  public:
+    /*! writes the acceleration structures of the committed scene to a file */
+    void save (const std::string& fileName);
+
+    /*! commits the scene using acceleration structures previously written by save */
+    void load (const std::string& fileName);
+
+    /*! returns the scene configuration a saved acceleration structure is valid for */
+    std::vector<unsigned int> getFileSignature() const;
+
+    /*! invokes the callback for all primitives near the query point */
+    bool pointQuery (RTCPointQuery* query, RTCPointQueryFunction func, void* userPtr);
+
+    /*! finds the closest point on all triangle and quad meshes of the scene */
+    bool closestPoint (RTCPointQuery* query, RTCClosestPoint* result);
+
+    /*! reports all pairs of overlapping primitives of this and some other scene */
+    void collide (Scene* other, RTCCollideFunction func, void* userPtr);
     void build () {}
 
     void updateInterface();
@@ -230,6 +259,7 @@ namespace embree
     __forceinline bool isFastAccel() const { return !isCompactAccel() && !isRobustAccel(); }
     __forceinline bool isCompactAccel() const { return scene_flags & RTC_SCENE_FLAG_COMPACT; }
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
+    __forceinline bool isQuantizedAccel() const { return (scene_flags & RTC_SCENE_FLAG_QUANTIZED) && !isRobustAccel(); }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
     
@@ -264,6 +294,11 @@ namespace embree
     SpinLock geometriesMutex;
     bool is_build;
     bool modified;                   //!< true if scene got modified
+    std::istream* accel_stream;      //!< if set, acceleration structures get loaded from this stream during commit
+    MutexSys commitThreadMutex;
+    thread_t commitThread;           //!< thread executing an asynchronous commit
+    RTCCommitSceneFunction commit_callback;
+    void* commit_callback_ptr;
     
     /*! global lock step task scheduler */
 #if defined(TASKING_INTERNAL) 
@@ -273,6 +273,11 @@ namespace embree
       n1 = madd(Vec3fa(f0),an1,f1*bn1);
     }
 
+    /* returns true if topology changed */
+    bool topologyChanged() const {
+      return curves.isModified() || numPrimitivesChanged;
+    }
+
   public:
     BufferView<unsigned int> curves;        //!< array of curve indices
     BufferView<Vec3fa> vertices0;           //!< fast access to first vertex buffer
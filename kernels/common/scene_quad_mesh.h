@@ -24,6 +24,7 @@ namespace embree
   /*! Quad Mesh */
   struct QuadMesh : public Geometry
   {
+    ALIGNED_STRUCT_(16);
     /*! type of this geometry */
     static const Geometry::GTypeMask geom_type = Geometry::MTY_QUAD_MESH;
     
@@ -51,6 +52,7 @@ namespace embree
     void setNumTimeSteps (unsigned int numTimeSteps);
     void setVertexAttributeCount (unsigned int N);
     void setBuffer(RTCBufferType type, unsigned int slot, RTCFormat format, const Ref<Buffer>& buffer, size_t offset, size_t stride, unsigned int num);
+    void setVertexDequantization(const Vec3fa& scale, const Vec3fa& offset);
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void preCommit();
@@ -71,7 +73,9 @@ namespace embree
     }
 
     /*! returns i'th vertex of itime'th timestep */
-    __forceinline const Vec3fa vertex(size_t i) const {
+    __forceinline const Vec3fa vertex(size_t i) const
+    {
+      if (unlikely(vertices0.getFormat() != RTC_FORMAT_FLOAT3)) return decodeVertex(vertices0.getPtr(i));
       return vertices0[i];
     }
 
@@ -81,34 +85,90 @@ namespace embree
     }
 
     /*! returns i'th vertex of itime'th timestep */
-    __forceinline const Vec3fa vertex(size_t i, size_t itime) const {
+    __forceinline const Vec3fa vertex(size_t i, size_t itime) const
+    {
+      if (unlikely(vertices[itime].getFormat() != RTC_FORMAT_FLOAT3)) return decodeVertex(vertices[itime].getPtr(i));
       return vertices[itime][i];
     }
 
+    /*! returns i'th vertex of itime'th timestep, stored in the vertex format given as template argument */
+    template<RTCFormat format>
+    __forceinline const Vec3fa vertex(size_t i, size_t itime) const {
+      return decodeVertex<format>(vertices[itime].getPtr(i));
+    }
+
     /*! returns i'th vertex of itime'th timestep */
     __forceinline const char* vertexPtr(size_t i, size_t itime) const {
       return vertices[itime].getPtr(i);
     }
 
-    /*! calculates the bounds of the i'th quad */
-    __forceinline BBox3fa bounds(size_t i) const 
+    /*! returns the vertex of the itime'th timestep at the 4 byte offset ofs, as stored by the indexed primitives */
+    __forceinline const Vec3fa vertexAtOffset(size_t ofs, size_t itime = 0) const
     {
-      const Quad& q = quad(i);
-      const Vec3fa v0 = vertex(q.v[0]);
-      const Vec3fa v1 = vertex(q.v[1]);
-      const Vec3fa v2 = vertex(q.v[2]);
-      const Vec3fa v3 = vertex(q.v[3]);
-      return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
+      const char* ptr = vertices[itime].getPtr() + 4*ofs;
+      if (unlikely(vertices[itime].getFormat() != RTC_FORMAT_FLOAT3)) return decodeVertex(ptr);
+      return Vec3fa::loadu(ptr);
+    }
+
+    /*! returns the vertex at the 4 byte offset ofs, stored in the vertex format given as template argument */
+    template<RTCFormat format>
+    __forceinline const Vec3fa vertexAtOffset(size_t ofs, size_t itime) const {
+      return decodeVertex<format>(vertices[itime].getPtr() + 4*ofs);
+    }
+
+    /*! returns true if the vertices are stored in half precision or 16-bit quantized format */
+    __forceinline bool compressedVertices() const {
+      return vertices0.getFormat() != RTC_FORMAT_FLOAT3;
+    }
+
+    /*! decodes a half precision or 16-bit quantized vertex */
+    __forceinline const Vec3fa decodeVertex(const char* ptr) const
+    {
+      if (vertices0.getFormat() == RTC_FORMAT_HALF3) return decodeVertex<RTC_FORMAT_HALF3>(ptr);
+      else                                           return decodeVertex<RTC_FORMAT_USHORT3>(ptr);
+    }
+
+    /*! decodes a vertex stored in the format given as template argument */
+    template<RTCFormat format>
+    __forceinline const Vec3fa decodeVertex(const char* ptr) const
+    {
+      const unsigned short* v = (const unsigned short*) ptr;
+      if (format == RTC_FORMAT_HALF3)
+        return madd(Vec3fa(half_to_float(v[0]),half_to_float(v[1]),half_to_float(v[2])),dequantScale,dequantOffset);
+      else if (format == RTC_FORMAT_USHORT3)
+        return madd(Vec3fa(float(v[0]),float(v[1]),float(v[2])),dequantScale,dequantOffset);
+      else
+        return Vec3fa::loadu(ptr);
+    }
+
+    /* The per primitive functions below are templated over the vertex
+     * format, so that builders decode the vertices without testing the
+     * format for each of them. The non-templated versions dispatch
+     * once per primitive. */
+
+    /*! calculates the bounds of the i'th quad */
+    __forceinline BBox3fa bounds(size_t i) const {
+      return bounds(i,size_t(0));
     }
 
     /*! calculates the bounds of the i'th quad at the itime'th timestep */
     __forceinline BBox3fa bounds(size_t i, size_t itime) const
+    {
+      switch (vertices0.getFormat()) {
+      case RTC_FORMAT_HALF3  : return bounds<RTC_FORMAT_HALF3>(i,itime);
+      case RTC_FORMAT_USHORT3: return bounds<RTC_FORMAT_USHORT3>(i,itime);
+      default                : return bounds<RTC_FORMAT_FLOAT3>(i,itime);
+      }
+    }
+
+    template<RTCFormat format>
+    __forceinline BBox3fa bounds(size_t i, size_t itime) const
     {
       const Quad& q = quad(i);
-      const Vec3fa v0 = vertex(q.v[0],itime);
-      const Vec3fa v1 = vertex(q.v[1],itime);
-      const Vec3fa v2 = vertex(q.v[2],itime);
-      const Vec3fa v3 = vertex(q.v[3],itime);
+      const Vec3fa v0 = vertex<format>(q.v[0],itime);
+      const Vec3fa v1 = vertex<format>(q.v[1],itime);
+      const Vec3fa v2 = vertex<format>(q.v[2],itime);
+      const Vec3fa v3 = vertex<format>(q.v[3],itime);
       return BBox3fa(min(v0,v1,v2,v3),max(v0,v1,v2,v3));
     }
 
@@ -119,6 +179,16 @@ namespace embree
 
     /*! check if the i'th primitive is valid between the specified time range */
     __forceinline bool valid(size_t i, const range<size_t>& itime_range) const
+    {
+      switch (vertices0.getFormat()) {
+      case RTC_FORMAT_HALF3  : return valid<RTC_FORMAT_HALF3>(i,itime_range);
+      case RTC_FORMAT_USHORT3: return valid<RTC_FORMAT_USHORT3>(i,itime_range);
+      default                : return valid<RTC_FORMAT_FLOAT3>(i,itime_range);
+      }
+    }
+
+    template<RTCFormat format>
+    __forceinline bool valid(size_t i, const range<size_t>& itime_range) const
     {
       const Quad& q = quad(i);
       if (unlikely(q.v[0] >= numVertices())) return false;
@@ -128,10 +198,10 @@ namespace embree
 
       for (size_t itime = itime_range.begin(); itime <= itime_range.end(); itime++)
       {
-        if (!isvalid(vertex(q.v[0],itime))) return false;
-        if (!isvalid(vertex(q.v[1],itime))) return false;
-        if (!isvalid(vertex(q.v[2],itime))) return false;
-        if (!isvalid(vertex(q.v[3],itime))) return false;
+        if (!isvalid(vertex<format>(q.v[0],itime))) return false;
+        if (!isvalid(vertex<format>(q.v[1],itime))) return false;
+        if (!isvalid(vertex<format>(q.v[2],itime))) return false;
+        if (!isvalid(vertex<format>(q.v[3],itime))) return false;
       }
 
       return true;
@@ -144,32 +214,51 @@ namespace embree
 
     /*! calculates the build bounds of the i'th primitive, if it's valid */
     __forceinline bool buildBounds(size_t i, BBox3fa* bbox = nullptr) const
+    {
+      switch (vertices0.getFormat()) {
+      case RTC_FORMAT_HALF3  : return buildBounds<RTC_FORMAT_HALF3>(i,bbox);
+      case RTC_FORMAT_USHORT3: return buildBounds<RTC_FORMAT_USHORT3>(i,bbox);
+      default                : return buildBounds<RTC_FORMAT_FLOAT3>(i,bbox);
+      }
+    }
+
+    template<RTCFormat format>
+    __forceinline bool buildBounds(size_t i, BBox3fa* bbox) const
     {
       const Quad& q = quad(i);
-      if (q.v[0] >= numVertices()) return false;
-      if (q.v[1] >= numVertices()) return false;
-      if (q.v[2] >= numVertices()) return false;
-      if (q.v[3] >= numVertices()) return false;
+      if (unlikely(q.v[0] >= numVertices())) return false;
+      if (unlikely(q.v[1] >= numVertices())) return false;
+      if (unlikely(q.v[2] >= numVertices())) return false;
+      if (unlikely(q.v[3] >= numVertices())) return false;
 
-      for (unsigned int t=0; t<numTimeSteps; t++)
+      for (size_t t=0; t<numTimeSteps; t++)
       {
-        const Vec3fa v0 = vertex(q.v[0],t);
-        const Vec3fa v1 = vertex(q.v[1],t);
-        const Vec3fa v2 = vertex(q.v[2],t);
-        const Vec3fa v3 = vertex(q.v[3],t);
-
+        const Vec3fa v0 = vertex<format>(q.v[0],t);
+        const Vec3fa v1 = vertex<format>(q.v[1],t);
+        const Vec3fa v2 = vertex<format>(q.v[2],t);
+        const Vec3fa v3 = vertex<format>(q.v[3],t);
         if (unlikely(!isvalid(v0) || !isvalid(v1) || !isvalid(v2) || !isvalid(v3)))
           return false;
       }
 
-      if (bbox) 
-        *bbox = bounds(i);
+      if (likely(bbox)) 
+        *bbox = bounds<format>(i,size_t(0));
 
       return true;
     }
 
     /*! calculates the build bounds of the i'th primitive at the itime'th time segment, if it's valid */
     __forceinline bool buildBounds(size_t i, size_t itime, BBox3fa& bbox) const
+    {
+      switch (vertices0.getFormat()) {
+      case RTC_FORMAT_HALF3  : return buildBounds<RTC_FORMAT_HALF3>(i,itime,bbox);
+      case RTC_FORMAT_USHORT3: return buildBounds<RTC_FORMAT_USHORT3>(i,itime,bbox);
+      default                : return buildBounds<RTC_FORMAT_FLOAT3>(i,itime,bbox);
+      }
+    }
+
+    template<RTCFormat format>
+    __forceinline bool buildBounds(size_t i, size_t itime, BBox3fa& bbox) const
     {
       const Quad& q = quad(i);
       if (unlikely(q.v[0] >= numVertices())) return false;
@@ -178,14 +267,14 @@ namespace embree
       if (unlikely(q.v[3] >= numVertices())) return false;
 
       assert(itime+1 < numTimeSteps);
-      const Vec3fa a0 = vertex(q.v[0],itime+0); if (unlikely(!isvalid(a0))) return false;
-      const Vec3fa a1 = vertex(q.v[1],itime+0); if (unlikely(!isvalid(a1))) return false;
-      const Vec3fa a2 = vertex(q.v[2],itime+0); if (unlikely(!isvalid(a2))) return false;
-      const Vec3fa a3 = vertex(q.v[3],itime+0); if (unlikely(!isvalid(a3))) return false;
-      const Vec3fa b0 = vertex(q.v[0],itime+1); if (unlikely(!isvalid(b0))) return false;
-      const Vec3fa b1 = vertex(q.v[1],itime+1); if (unlikely(!isvalid(b1))) return false;
-      const Vec3fa b2 = vertex(q.v[2],itime+1); if (unlikely(!isvalid(b2))) return false;
-      const Vec3fa b3 = vertex(q.v[3],itime+1); if (unlikely(!isvalid(b3))) return false;
+      const Vec3fa a0 = vertex<format>(q.v[0],itime+0); if (unlikely(!isvalid(a0))) return false;
+      const Vec3fa a1 = vertex<format>(q.v[1],itime+0); if (unlikely(!isvalid(a1))) return false;
+      const Vec3fa a2 = vertex<format>(q.v[2],itime+0); if (unlikely(!isvalid(a2))) return false;
+      const Vec3fa a3 = vertex<format>(q.v[3],itime+0); if (unlikely(!isvalid(a3))) return false;
+      const Vec3fa b0 = vertex<format>(q.v[0],itime+1); if (unlikely(!isvalid(b0))) return false;
+      const Vec3fa b1 = vertex<format>(q.v[1],itime+1); if (unlikely(!isvalid(b1))) return false;
+      const Vec3fa b2 = vertex<format>(q.v[2],itime+1); if (unlikely(!isvalid(b2))) return false;
+      const Vec3fa b3 = vertex<format>(q.v[3],itime+1); if (unlikely(!isvalid(b3))) return false;
       
       /* use bounds of first time step in builder */
       bbox = BBox3fa(min(a0,a1,a2,a3),max(a0,a1,a2,a3));
@@ -193,8 +282,18 @@ namespace embree
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
+    __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& time_range) const
+    {
+      switch (vertices0.getFormat()) {
+      case RTC_FORMAT_HALF3  : return linearBounds<RTC_FORMAT_HALF3>(primID,time_range);
+      case RTC_FORMAT_USHORT3: return linearBounds<RTC_FORMAT_USHORT3>(primID,time_range);
+      default                : return linearBounds<RTC_FORMAT_FLOAT3>(primID,time_range);
+      }
+    }
+
+    template<RTCFormat format>
     __forceinline LBBox3fa linearBounds(size_t primID, const BBox1f& time_range) const {
-      return LBBox3fa([&] (size_t itime) { return bounds(primID, itime); }, time_range, fnumTimeSegments);
+      return LBBox3fa([&] (size_t itime) { return bounds<format>(primID, itime); }, time_range, fnumTimeSegments);
     }
 
     /*! calculates the linear bounds of the i'th primitive for the specified time range */
@@ -215,6 +314,8 @@ namespace embree
     BufferView<Vec3fa> vertices0;           //!< fast access to first vertex buffer
     vector<BufferView<Vec3fa>> vertices;    //!< vertex array for each timestep
     vector<BufferView<char>> vertexAttribs; //!< vertex attribute buffers
+    Vec3fa dequantScale;                    //!< scale applied to compressed vertices
+    Vec3fa dequantOffset;                   //!< offset applied to compressed vertices
   };
 
   namespace isa
@@ -224,13 +325,24 @@ namespace embree
       QuadMeshISA (Device* device)
         : QuadMesh(device) {}
 
+      /* the vertex format is dispatched once per range of primitives */
+      PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k) const
+      {
+        switch (vertices0.getFormat()) {
+        case RTC_FORMAT_HALF3  : return createPrimRefArray<RTC_FORMAT_HALF3>(prims,r,k);
+        case RTC_FORMAT_USHORT3: return createPrimRefArray<RTC_FORMAT_USHORT3>(prims,r,k);
+        default                : return createPrimRefArray<RTC_FORMAT_FLOAT3>(prims,r,k);
+        }
+      }
+
+      template<RTCFormat format>
       PrimInfo createPrimRefArray(mvector<PrimRef>& prims, const range<size_t>& r, size_t k) const
       {
         PrimInfo pinfo(empty);
         for (size_t j=r.begin(); j<r.end(); j++)
         {
           BBox3fa bounds = empty;
-          if (!buildBounds(j,&bounds)) continue;
+          if (!buildBounds<format>(j,&bounds)) continue;
           const PrimRef prim(bounds,geomID,unsigned(j));
           pinfo.add_center2(prim);
           prims[k++] = prim;
@@ -238,13 +350,23 @@ namespace embree
         return pinfo;
       }
 
+      PrimInfo createPrimRefArrayMB(mvector<PrimRef>& prims, size_t itime, const range<size_t>& r, size_t k) const
+      {
+        switch (vertices0.getFormat()) {
+        case RTC_FORMAT_HALF3  : return createPrimRefArrayMB<RTC_FORMAT_HALF3>(prims,itime,r,k);
+        case RTC_FORMAT_USHORT3: return createPrimRefArrayMB<RTC_FORMAT_USHORT3>(prims,itime,r,k);
+        default                : return createPrimRefArrayMB<RTC_FORMAT_FLOAT3>(prims,itime,r,k);
+        }
+      }
+
+      template<RTCFormat format>
       PrimInfo createPrimRefArrayMB(mvector<PrimRef>& prims, size_t itime, const range<size_t>& r, size_t k) const
       {
         PrimInfo pinfo(empty);
         for (size_t j=r.begin(); j<r.end(); j++)
         {
           BBox3fa bounds = empty;
-          if (!buildBounds(j,itime,bounds)) continue;
+          if (!buildBounds<format>(j,itime,bounds)) continue;
           const PrimRef prim(bounds,geomID,unsigned(j));
           pinfo.add_center2(prim);
           prims[k++] = prim;
@@ -252,13 +374,23 @@ namespace embree
         return pinfo;
       }
       
+      PrimInfoMB createPrimRefMBArray(mvector<PrimRefMB>& prims, const BBox1f& t0t1, const range<size_t>& r, size_t k) const
+      {
+        switch (vertices0.getFormat()) {
+        case RTC_FORMAT_HALF3  : return createPrimRefMBArray<RTC_FORMAT_HALF3>(prims,t0t1,r,k);
+        case RTC_FORMAT_USHORT3: return createPrimRefMBArray<RTC_FORMAT_USHORT3>(prims,t0t1,r,k);
+        default                : return createPrimRefMBArray<RTC_FORMAT_FLOAT3>(prims,t0t1,r,k);
+        }
+      }
+
+      template<RTCFormat format>
       PrimInfoMB createPrimRefMBArray(mvector<PrimRefMB>& prims, const BBox1f& t0t1, const range<size_t>& r, size_t k) const
       {
         PrimInfoMB pinfo(empty);
         for (size_t j=r.begin(); j<r.end(); j++)
         {
-          if (!valid(j, getTimeSegmentRange(t0t1, fnumTimeSegments))) continue;
-          const PrimRefMB prim(linearBounds(j,t0t1),this->numTimeSegments(),this->numTimeSegments(),this->geomID,unsigned(j));
+          if (!valid<format>(j, getTimeSegmentRange(t0t1, fnumTimeSegments))) continue;
+          const PrimRefMB prim(linearBounds<format>(j,t0t1),this->numTimeSegments(),this->numTimeSegments(),this->geomID,unsigned(j));
           pinfo.add_primref(prim);
           prims[k++] = prim;
         }
@@ -31,6 +31,10 @@ namespace embree
     : Geometry(device,GTY_SUBDIV_MESH,0,1), 
       displFunc(nullptr),
       tessellationRate(2.0f),
+      adaptiveTessellation(false),
+      tessellationCamera(zero),
+      minTessellationLevel(1.0f),
+      maxTessellationLevel(4096.0f),
       numHalfEdges(0),
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
@@ -377,6 +381,18 @@ namespace embree
     levels.setModified(true);
   }
 
+  void SubdivMesh::setAdaptiveTessellation(bool enable, const Vec3fa& position, float minLevel, float maxLevel)
+  {
+    if (enable && !(minLevel >= 1.0f && minLevel <= maxLevel && maxLevel <= 4096.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid tessellation level range");
+
+    adaptiveTessellation = enable;
+    tessellationCamera = position;
+    minTessellationLevel = minLevel;
+    maxTessellationLevel = maxLevel;
+    levels.setModified(true);
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -458,7 +474,7 @@ namespace embree
 	  edge->opposite_half_edge_ofs = 0;
 	  edge->edge_crease_weight     = mesh->edgeCreaseMap.lookup(key0,0.0f);
 	  edge->vertex_crease_weight   = mesh->vertexCreaseMap.lookup(startVertex0,0.0f);
-	  edge->edge_level             = mesh->getEdgeLevel(e+de);
+	  edge->edge_level             = mesh->getEdgeLevel(e+de,startVertex0,endVertex0);
           edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
           edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
 
@@ -590,7 +606,7 @@ namespace embree
 	HalfEdge& edge = halfEdges[i];
 
 	if (updateLevels)
-	  edge.edge_level = mesh->getEdgeLevel(i); 
+	  edge.edge_level = mesh->getEdgeLevel(i,halfEdgesGeom[i].vtx_index,halfEdgesGeom[i].next()->vtx_index); 
         
 	if (updateEdgeCreases) {
 	  if (edge.hasOpposite()) // leave weight at inf for borders
@@ -721,6 +737,10 @@ namespace embree
     if (holes.isModified())
       holeSet.init(holes);
 
+    /* view dependent edge levels change with the vertices */
+    if (adaptiveTessellation && vertices[0].isModified())
+      levels.setModified(true);
+
     /* create topology */
     for (auto& t: topology)
       t.initializeHalfEdgeStructures();
@@ -883,7 +903,7 @@ namespace embree
       for (unsigned int i=0; i<valueCount; i+=4)
       {
         vfloat4 Pt, dPdut, dPdvt, ddPdudut, ddPdvdvt, ddPdudvt;
-        isa::PatchEval<vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,i/4,stride)),commitCounter,
+        isa::PatchEval<vfloat4,vfloat4>(*device->tessellationCache,baseEntry->at(interpolationSlot(primID,i/4,stride)),commitCounter,
                                         topo->getHalfEdge(primID),src+i*sizeof(float),stride,u,v,
                                         has_P ? &Pt : nullptr, 
                                         has_dP ? &dPdut : nullptr, 
@@ -970,7 +990,7 @@ namespace embree
                          for (unsigned int j=0; j<valueCount; j+=4) 
                          {
                            const size_t M = min(4u,valueCount-j);
-                           isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
+                           isa::PatchEvalSimd<vbool4,vint4,vfloat4,vfloat4>(*device->tessellationCache,baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
                                                                             topo->getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
                                                                             P ? P+j*N+i : nullptr,
                                                                             dPdu ? dPdu+j*N+i : nullptr,
@@ -76,6 +76,7 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setAdaptiveTessellation(bool enable, const Vec3fa& position, float minLevel, float maxLevel);
     bool verify();
     void commit();
     void setDisplacementFunction (RTCDisplacementFunctionN func);
@@ -130,13 +131,25 @@ namespace embree
       return vertices[t];
     }
 
-    /* returns tessellation level of edge */
-    __forceinline float getEdgeLevel(const size_t i) const
+    /* returns tessellation level of edge i that connects the vertices v0 and v1 */
+    __forceinline float getEdgeLevel(const size_t i, const unsigned int v0, const unsigned int v1) const
     {
       if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
+      else if (adaptiveTessellation) return getAdaptiveEdgeLevel(v0,v1);
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* returns view dependent tessellation level of the edge between v0 and v1, which is the same for both half edges of the edge */
+    __forceinline float getAdaptiveEdgeLevel(const unsigned int v0, const unsigned int v1) const
+    {
+      if (v0 >= numVertices() || v1 >= numVertices()) return clamp(tessellationRate,1.0f,4096.0f);
+      const Vec3fa p0 = vertices[0][v0];
+      const Vec3fa p1 = vertices[0][v1];
+      const float dist = max(length(0.5f*(p0+p1)-tessellationCamera),1E-6f);
+      const float level = tessellationRate*length(p1-p0)/dist;
+      return clamp(level,minTessellationLevel,maxTessellationLevel);
+    }
+
   public:
     RTCDisplacementFunctionN displFunc;    //!< displacement function
 
@@ -270,6 +283,12 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! view dependent tessellation that is used when levels is not set */
+    bool adaptiveTessellation;     //!< scales the tessellation rate by the length of the edge relative to its distance to the camera
+    Vec3fa tessellationCamera;     //!< camera position for view dependent tessellation
+    float minTessellationLevel;    //!< minimal view dependent edge level
+    float maxTessellationLevel;    //!< maximal view dependent edge level
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
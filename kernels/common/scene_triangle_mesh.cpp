@@ -22,7 +22,7 @@ namespace embree
 #if defined(EMBREE_LOWEST_ISA)
 
   TriangleMesh::TriangleMesh (Device* device)
-    : Geometry(device,GTY_TRIANGLE_MESH,0,1)
+    : Geometry(device,GTY_TRIANGLE_MESH,0,1), dequantScale(one), dequantOffset(zero)
   {
     vertices.resize(numTimeSteps);
   }
@@ -65,9 +65,13 @@ namespace embree
 
     if (type == RTC_BUFFER_TYPE_VERTEX)
     {
-      if (format != RTC_FORMAT_FLOAT3)
+      if (format != RTC_FORMAT_FLOAT3 && format != RTC_FORMAT_HALF3 && format != RTC_FORMAT_USHORT3)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "invalid vertex buffer format");
 
+      /* indexed primitives store vertex offsets in units of 4 bytes, thus compressed vertices need a padded stride */
+      if (format != RTC_FORMAT_FLOAT3 && (stride < 8 || (stride & 0x3)))
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION, "stride of compressed vertex buffers has to be a multiple of 4 bytes and at least 8 bytes");
+
       /* if buffer is larger than 16GB the premultiplied index optimization does not work */
       if (stride*num > 16ll*1024ll*1024ll*1024ll)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION, "vertex buffer can be at most 16GB large");
@@ -76,7 +80,8 @@ namespace embree
         throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid vertex buffer slot");
 
       vertices[slot].set(buffer, offset, stride, num, format);
-      vertices[slot].checkPadding16();
+      if (format == RTC_FORMAT_FLOAT3)
+        vertices[slot].checkPadding16();
       vertices0 = vertices[0];
     }
     else if (type == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE)
@@ -104,6 +109,15 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown buffer type");
   }
 
+  void TriangleMesh::setVertexDequantization(const Vec3fa& scale, const Vec3fa& offset)
+  {
+    dequantScale = scale;
+    dequantOffset = offset;
+    for (auto& buf : vertices)
+      buf.setModified(true);
+    Geometry::update();
+  }
+
   void* TriangleMesh::getBuffer(RTCBufferType type, unsigned int slot)
   {
     if (type == RTC_BUFFER_TYPE_INDEX)
@@ -166,12 +180,18 @@ namespace embree
       if (vertices[t].getStride() != vertices[0].getStride())
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stride of vertex buffers have to be identical for each time step");
 
+    /* verify that format of all time steps are identical */
+    for (unsigned int t=0; t<numTimeSteps; t++)
+      if (vertices[t].getFormat() != vertices[0].getFormat())
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"format of vertex buffers have to be identical for each time step");
+
     Geometry::preCommit();
   }
 
   void TriangleMesh::postCommit() 
   {
-    scene->vertices[geomID] = (float*) vertices0.getPtr();
+    /* indexed primitives decode compressed vertices through the mesh */
+    scene->vertices[geomID] = compressedVertices() ? nullptr : (float*) vertices0.getPtr();
 
     triangles.setModified(false);
     for (auto& buf : vertices)
@@ -203,9 +223,9 @@ namespace embree
     }
 
     /*! verify vertices */
-    for (const auto& buffer : vertices)
-      for (size_t i=0; i<buffer.size(); i++)
-	if (!isvalid(buffer[i])) 
+    for (size_t t=0; t<numTimeSteps; t++)
+      for (size_t i=0; i<numVertices(); i++)
+	if (!isvalid(vertex(i,t))) 
 	  return false;
 
     return true;
@@ -231,6 +251,7 @@ namespace embree
            (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot <= vertexAttribs.size()));
     const char* src = nullptr; 
     size_t stride = 0;
+    const bool decode = bufferType == RTC_BUFFER_TYPE_VERTEX && compressedVertices();
     if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
       src    = vertexAttribs[bufferSlot].getPtr();
       stride = vertexAttribs[bufferSlot].getStride();
@@ -245,9 +266,16 @@ namespace embree
       const float w = 1.0f-u-v;
       const Triangle& tri = triangle(primID);
       const vbool4 valid = vint4((int)i)+vint4(step) < vint4(int(valueCount));
-      const vfloat4 p0 = vfloat4::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
-      const vfloat4 p1 = vfloat4::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
-      const vfloat4 p2 = vfloat4::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
+      vfloat4 p0, p1, p2;
+      if (unlikely(decode)) {
+        p0 = (vfloat4) vertex(tri.v[0],bufferSlot);
+        p1 = (vfloat4) vertex(tri.v[1],bufferSlot);
+        p2 = (vfloat4) vertex(tri.v[2],bufferSlot);
+      } else {
+        p0 = vfloat4::loadu(valid,(float*)&src[tri.v[0]*stride+ofs]);
+        p1 = vfloat4::loadu(valid,(float*)&src[tri.v[1]*stride+ofs]);
+        p2 = vfloat4::loadu(valid,(float*)&src[tri.v[2]*stride+ofs]);
+      }
       
       if (P) {
         vfloat4::storeu(valid,P+i,madd(w,p0,madd(u,p1,v*p2)));
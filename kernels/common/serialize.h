@@ -0,0 +1,68 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! writes raw bytes to a binary stream */
+  __forceinline void writeBytes(std::ostream& stream, const void* ptr, size_t bytes)
+  {
+    stream.write((const char*)ptr,bytes);
+    if (!stream) throw_RTCError(RTC_ERROR_UNKNOWN,"error writing to file");
+  }
+
+  /*! reads raw bytes from a binary stream */
+  __forceinline void readBytes(std::istream& stream, void* ptr, size_t bytes)
+  {
+    stream.read((char*)ptr,bytes);
+    if (!stream) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"unexpected end of file");
+  }
+
+  /*! writes a trivially copyable value to a binary stream */
+  template<typename T>
+  __forceinline void writeBinary(std::ostream& stream, const T& value) {
+    writeBytes(stream,&value,sizeof(T));
+  }
+
+  /*! reads a trivially copyable value from a binary stream */
+  template<typename T>
+  __forceinline T readBinary(std::istream& stream)
+  {
+    T value;
+    readBytes(stream,&value,sizeof(T));
+    return value;
+  }
+
+  /*! writes a length prefixed string to a binary stream */
+  __forceinline void writeString(std::ostream& stream, const std::string& str)
+  {
+    writeBinary(stream,(unsigned int)str.size());
+    writeBytes(stream,str.data(),str.size());
+  }
+
+  /*! reads a length prefixed string from a binary stream */
+  __forceinline std::string readString(std::istream& stream)
+  {
+    const unsigned int size = readBinary<unsigned int>(stream);
+    if (size > 4096) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid string in file");
+    std::string str(size,'\0');
+    readBytes(stream,&str[0],size);
+    return str;
+  }
+}
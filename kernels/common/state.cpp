@@ -111,6 +111,16 @@ namespace embree
     instancing_open_max_depth = 32;
     instancing_open_max = 50000000;
 
+    toplevel_update_ratio = 0.0f;
+    toplevel_update_max_sah = 1.25f;
+
+    morton_code64_threshold = 4*1024*1024;
+
+    restructure_passes = 0;
+    node_clustering_threshold = 1024*1024;
+
+    stream_sort_size = 0;
+
     ignore_config_files = false;
     float_exceptions = false;
     quality_flags = -1;
@@ -373,6 +383,22 @@ namespace embree
       else if (tok == Token::Id("instancing_open_max") && cin->trySymbol("="))
         instancing_open_max = cin->get().Int();
 
+      else if (tok == Token::Id("toplevel_update_ratio") && cin->trySymbol("="))
+        toplevel_update_ratio = cin->get().Float();
+      else if (tok == Token::Id("toplevel_update_max_sah") && cin->trySymbol("="))
+        toplevel_update_max_sah = cin->get().Float();
+
+      else if (tok == Token::Id("morton_code64_threshold") && cin->trySymbol("="))
+        morton_code64_threshold = cin->get().Int();
+
+      else if (tok == Token::Id("restructure_passes") && cin->trySymbol("="))
+        restructure_passes = cin->get().Int();
+      else if (tok == Token::Id("node_clustering_threshold") && cin->trySymbol("="))
+        node_clustering_threshold = cin->get().Int();
+
+      else if (tok == Token::Id("stream_sort_size") && cin->trySymbol("="))
+        stream_sort_size = cin->get().Int();
+
       else if (tok == Token::Id("subdiv_accel") && cin->trySymbol("="))
         subdiv_accel = cin->get().Identifier();
       else if (tok == Token::Id("subdiv_accel_mb") && cin->trySymbol("="))
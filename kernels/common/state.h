@@ -117,7 +117,7 @@ namespace embree
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
-    size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t tessellation_cache_size;        //!< size of the tessellation cache of the device
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -126,6 +126,20 @@ namespace embree
     size_t instancing_open_max_depth;      //!< maximum open depth for geometries
     size_t instancing_open_max;            //!< instancing opens tree to maximally that number of subtrees
 
+  public:
+    float toplevel_update_ratio;           //!< two level builder updates top level BVH incrementally if at most that fraction of objects changed
+    float toplevel_update_max_sah;         //!< two level builder rebuilds top level BVH if incremental updates increased its SAH cost by more than that factor
+
+  public:
+    size_t morton_code64_threshold;        //!< morton builder uses 64 bit morton codes for meshes with at least that many primitives
+
+  public:
+    size_t restructure_passes;             //!< number of treelet restructuring passes for high quality BVHs
+    size_t node_clustering_threshold;      //!< BVHs with at least that many primitives get their nodes laid out in page sized clusters
+
+  public:
+    size_t stream_sort_size;               //!< incoherent ray streams get sorted by direction and origin in blocks of that many rays, 0 disables sorting
+
   public:
     bool ignore_config_files;              //!< if true no more config files get parse
     bool float_exceptions;                 //!< enable floating point exceptions
@@ -129,6 +129,59 @@ namespace embree
       }
       return bvh->encodeLeaf((char*)accel,items);
     };
+
+    /*! gathers primrefs of all curves of this block from their geometry */
+    __forceinline BBox3fa primRefs(PrimRef* prims, Scene* scene) const
+    {
+      const unsigned int geomID = this->geomID(N);
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<N; i++)
+      {
+        const unsigned int primID = this->primID(N)[i];
+        prims[i] = PrimRef(scene->get(geomID)->vbounds(primID),geomID,primID);
+        bounds.extend(prims[i].bounds());
+      }
+      return bounds;
+    }
+
+    /*! re-encodes the curves of this block after their vertices changed */
+    __forceinline BBox3fa update(Scene* scene)
+    {
+      PrimRef prims[M];
+      const size_t items = N;
+      const BBox3fa bounds = primRefs(prims,scene);
+      size_t begin = 0;
+      fill(prims,begin,items,scene);
+      return bounds;
+    }
+
+    /*! calculates the bounds of all curves of this block in the specified space */
+    __forceinline BBox3fa bounds(Scene* scene, const LinearSpace3fa& space) const
+    {
+      const Geometry* mesh = scene->get(geomID(N));
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<N; i++)
+        bounds.extend(mesh->vbounds(space,primID(N)[i]));
+      return bounds;
+    }
+
+    /*! re-encodes all curve blocks of a leaf */
+    static __forceinline BBox3fa updateLeaf(char* leaf, size_t items, Scene* scene)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<items; i++)
+        bounds.extend(((CurveNi*)leaf)[i].update(scene));
+      return bounds;
+    }
+
+    /*! calculates the bounds of all curve blocks of a leaf in the specified space */
+    static __forceinline BBox3fa leafBounds(const char* leaf, size_t items, Scene* scene, const LinearSpace3fa& space)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<items; i++)
+        bounds.extend(((const CurveNi*)leaf)[i].bounds(scene,space));
+      return bounds;
+    }
     
   public:
     
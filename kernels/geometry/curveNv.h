@@ -99,6 +99,49 @@ namespace embree
       }
       return bvh->encodeLeaf((char*)accel,items);
     };
+
+    /*! re-encodes the curves of this block after their vertices changed */
+    __forceinline BBox3fa update(Scene* scene)
+    {
+      PrimRef prims[M];
+      const size_t items = N;
+      const BBox3fa bounds = this->primRefs(prims,scene);
+      size_t begin = 0;
+      CurveNv::fill(prims,begin,items,scene);
+      CurveNi<M>::fill(prims,begin,items,scene);
+      return bounds;
+    }
+
+    /*! oriented and Hermite curves fall back to CurveNi leaves */
+    static __forceinline bool isCurveNiLeaf(const char* leaf)
+    {
+      const Geometry::GType ty = (Geometry::GType) ((const CurveNi<M>*)leaf)->ty;
+      return (ty & Geometry::GTY_SUBTYPE_MASK) == Geometry::GTY_SUBTYPE_ORIENTED_CURVE || (ty & Geometry::GTY_BASIS_MASK) == Geometry::GTY_BASIS_HERMITE;
+    }
+
+    /*! re-encodes all curve blocks of a leaf */
+    static __forceinline BBox3fa updateLeaf(char* leaf, size_t items, Scene* scene)
+    {
+      if (isCurveNiLeaf(leaf))
+        return CurveNi<M>::updateLeaf(leaf,items,scene);
+
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<items; i++)
+        bounds.extend(((CurveNv*)leaf)[i].update(scene));
+      return bounds;
+    }
+
+    /*! calculates the bounds of all curve blocks of a leaf in the specified space */
+    static __forceinline BBox3fa leafBounds(const char* leaf, size_t items, Scene* scene, const LinearSpace3fa& space)
+    {
+      if (isCurveNiLeaf(leaf))
+        return CurveNi<M>::leafBounds(leaf,items,scene,space);
+
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<items; i++)
+        bounds.extend(((const CurveNv*)leaf)[i].bounds(scene,space));
+      return bounds;
+    }
     
   public:
     unsigned char data[4*16*M];
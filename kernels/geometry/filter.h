@@ -25,11 +25,19 @@ namespace embree
 {
   namespace isa
   {
+    /* counts the invocation of a filter function in the traversal statistics */
+    __forceinline void countFilterInvocation(IntersectContext* context)
+    {
+      RTCTraversalStatistics* stats = context->statistics();
+      if (unlikely(stats)) stats->filters++;
+    }
+
     __forceinline bool runIntersectionFilter1Helper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, IntersectContext* context)
     {
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -38,6 +46,7 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -68,6 +77,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->intersectionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->intersectionFilterN(filter_args);
       }
       
@@ -76,6 +86,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(filter_args);
       }
 #endif
@@ -86,6 +97,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -94,6 +106,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -102,6 +115,18 @@ namespace embree
       return true;
     }
 
+    /* attenuates the transmittance of the ray by the opacity of a transparent geometry, returns true if the ray got occluded */
+    __forceinline bool attenuateTransmittance1(const Geometry* const geometry, const Ray& ray, IntersectContext* context)
+    {
+      float* transmittance = context->transmittance();
+      if (likely(!geometry->isTransparent() || transmittance == nullptr))
+        return true;
+
+      float& T = transmittance[(unsigned int)ray.id];
+      T *= 1.0f-geometry->opacity;
+      return T < context->user->minTransmittance;
+    }
+
     __forceinline bool runOcclusionFilter1(const Geometry* const geometry, Ray& ray, IntersectContext* context, Hit& hit)
     {
       RTCFilterFunctionNArguments args;
@@ -112,7 +137,9 @@ namespace embree
       args.ray = (RTCRayN*)&ray;
       args.hit = (RTCHitN*)&hit;
       args.N = 1;
-      return runOcclusionFilter1Helper(&args,geometry,context);
+      if (!runOcclusionFilter1Helper(&args,geometry,context))
+        return false;
+      return attenuateTransmittance1(geometry,ray,context);
     }
 
     __forceinline void reportOcclusion1(OccludedFunctionNArguments* args, const RTCFilterFunctionNArguments* filter_args)
@@ -122,6 +149,7 @@ namespace embree
       const Geometry* const geometry = args->geometry;
       if (geometry->occlusionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->occlusionFilterN(filter_args);
       }
       
@@ -130,6 +158,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(filter_args);
       }
 #endif
@@ -142,6 +171,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->intersectionFilterN(args);
       }
 
@@ -150,6 +180,7 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(args);
       }
 
@@ -174,6 +205,24 @@ namespace embree
       return runIntersectionFilterHelper<K>(&args,geometry,context);
     }
 
+    template<int K>
+      __forceinline vbool<K> attenuateTransmittance(const vbool<K>& valid, const Geometry* const geometry, const RayK<K>& ray, IntersectContext* context)
+    {
+      float* transmittance = context->transmittance();
+      if (likely(!geometry->isTransparent() || transmittance == nullptr))
+        return valid;
+
+      size_t m_occluded = 0;
+      for (size_t m_valid=movemask(valid); m_valid; )
+      {
+        const size_t k = bscf(m_valid);
+        float& T = transmittance[(unsigned int)ray.id[k]];
+        T *= 1.0f-geometry->opacity;
+        if (T < context->user->minTransmittance) m_occluded |= size_t(1) << k;
+      }
+      return valid & vbool<K>((int)m_occluded);
+    }
+
     template<int K>
       __forceinline vbool<K> runOcclusionFilterHelper(RTCFilterFunctionNArguments* args, const Geometry* const geometry, IntersectContext* context)
     {
@@ -181,6 +230,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        countFilterInvocation(context);
         geometry->occlusionFilterN(args);
       }
 
@@ -190,12 +240,14 @@ namespace embree
 
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        countFilterInvocation(context);
         context->user->filter(args);
       }
 
       valid_o = *mask != vint<K>(zero);
 
       RayK<K>* ray = (RayK<K>*) args->ray;
+      valid_o = attenuateTransmittance(valid_o,geometry,*ray,context);
       ray->tfar = select(valid_o, vfloat<K>(neg_inf), ray->tfar);
       return valid_o;
     }
@@ -77,6 +77,16 @@ namespace embree
       return instance->linearBounds(0,time_range);
     }
 
+    /* Updates the primitive */
+    __forceinline BBox3fa update(const Scene *const scene) const {
+      return instance->bounds(0);
+    }
+
+    /* Calculates the linear bounds of the primitive for the specified time range */
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f time_range) const {
+      return instance->linearBounds(0,time_range);
+    }
+
   public:
     const Instance* instance;
   };
@@ -16,6 +16,7 @@
 
 #include "instance_intersector.h"
 #include "../common/scene.h"
+#include "../common/instance_stack.h"
 
 namespace embree
 {
@@ -32,17 +33,19 @@ namespace embree
 #endif
 
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local();
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
     }
     
     bool InstanceIntersector1::occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const InstancePrimitive& prim)
@@ -56,17 +59,19 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local();
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        const AffineSpace3fa world2local = instance->getWorld2Local();
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
       return ray.tfar < 0.0f;
     }
 
@@ -81,17 +86,19 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());      
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect((RTCRayHit&)ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
     }
     
     bool InstanceIntersector1MB::occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const InstancePrimitive& prim)
@@ -105,17 +112,19 @@ namespace embree
 #endif
       
       RTCIntersectContext* user_context = context->user;
-      const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
-      const Vec3fa ray_org = ray.org;
-      const Vec3fa ray_dir = ray.dir;
-      ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
-      ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        const AffineSpace3fa world2local = instance->getWorld2Local(ray.time());
+        const Vec3fa ray_org = ray.org;
+        const Vec3fa ray_dir = ray.dir;
+        ray.org = Vec3fa(xfmPoint (world2local,ray_org),ray.tnear());
+        ray.dir = Vec3fa(xfmVector(world2local,ray_dir),ray.time());
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded((RTCRay&)ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
       return ray.tfar < 0.0f;
     }
     
@@ -132,17 +141,19 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local();
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
     }
 
     template<int K>
@@ -158,17 +169,19 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local();
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        AffineSpace3vf<K> world2local = instance->getWorld2Local();
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
       return ray.tfar < 0.0f;
     }
 
@@ -185,17 +198,19 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.intersect(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.intersect(valid,ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
     }
 
     template<int K>
@@ -211,17 +226,19 @@ namespace embree
 #endif
         
       RTCIntersectContext* user_context = context->user;
-      AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
-      const Vec3vf<K> ray_org = ray.org;
-      const Vec3vf<K> ray_dir = ray.dir;
-      ray.org = xfmPoint (world2local,ray_org);
-      ray.dir = xfmVector(world2local,ray_dir);
-      user_context->instID[0] = instance->geomID;
-      IntersectContext newcontext((Scene*)instance->object,user_context);
-      instance->object->intersectors.occluded(valid,ray,&newcontext);
-      user_context->instID[0] = -1;
-      ray.org = ray_org;
-      ray.dir = ray_dir;
+      if (likely(instance_id_stack::push(user_context, instance->geomID)))
+      {
+        AffineSpace3vf<K> world2local = instance->getWorld2Local<K>(valid,ray.time());
+        const Vec3vf<K> ray_org = ray.org;
+        const Vec3vf<K> ray_dir = ray.dir;
+        ray.org = xfmPoint (world2local,ray_org);
+        ray.dir = xfmVector(world2local,ray_dir);
+        IntersectContext newcontext((Scene*)instance->object,user_context);
+        instance->object->intersectors.occluded(valid,ray,&newcontext);
+        ray.org = ray_org;
+        ray.dir = ray_dir;
+        instance_id_stack::pop(user_context);
+      }
       return ray.tfar < 0.0f;
     }
 
@@ -90,6 +90,13 @@ namespace embree
       return mesh->bounds(primID());
     }
 
+    /* Calculates the linear bounds of the primitive for the specified time range */
+    __forceinline LBBox3fa linearBounds(const Scene *const scene, const BBox1f time_range) const
+    {
+      const AccelSet* accel = (const AccelSet*) scene->get(geomID());
+      return accel->linearBounds(primID(),time_range);
+    }
+
   private:
     unsigned int _geomID;  //!< geometry ID
     unsigned int _primID;  //!< primitive ID
@@ -269,9 +269,8 @@ namespace embree
         /* Calculate the bounds of the subgrid */
         __forceinline const BBox3fa bounds(const Scene *const scene, const size_t itime=0) const
         {
-          BBox3fa bounds = empty;
-          FATAL("not implemented yet");
-          return bounds;
+          const GridMesh* const mesh = scene->get<GridMesh>(geomID());
+          return mesh->bounds(mesh->grid(primID()),x(),y(),itime);
         }
 
         /* Calculate the linear bounds of the primitive */
@@ -385,6 +384,25 @@ namespace embree
           return SubGrid(x(i),y(i),geomID(),primID(i));
         }
 
+        /* Updates the quantized bounds of all subgrids */
+        __forceinline BBox3fa update(const Scene *const scene)
+        {
+          const size_t items = size();
+          unsigned int x[N], y[N], primID[N];
+          BBox3fa bounds[N];
+          BBox3fa allBounds = empty;
+          for (size_t i=0;i<items;i++)
+          {
+            x[i] = subgridIDs[i].x;
+            y[i] = subgridIDs[i].y;
+            primID[i] = subgridIDs[i].primID;
+            bounds[i] = subgrid(i).bounds(scene);
+            allBounds.extend(bounds[i]);
+          }
+          new (this) SubGridQBVHN(x,y,primID,bounds,geomID(),(unsigned int)items);
+          return allBounds;
+        }
+
       public:
         SubGridID subgridIDs[N];
 
@@ -77,9 +77,13 @@ namespace embree
     __forceinline unsigned int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
 
     /* loads a single vertex */
-    __forceinline Vec3f& getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
+    __forceinline Vec3f getVertex(const vuint<M>& v, const size_t index, const Scene *const scene) const
     {
       const float* vertices = scene->vertices[geomID(index)];
+      if (unlikely(vertices == nullptr)) {
+        const Vec3fa p = scene->get<TriangleMesh>(geomID(index))->vertexAtOffset(v[index]);
+        return Vec3f(p.x,p.y,p.z);
+      }
       return (Vec3f&) vertices[v[index]];
     }
 
@@ -87,10 +91,8 @@ namespace embree
     __forceinline Vec3<T> getVertex(const vuint<M>& v, const size_t index, const Scene *const scene, const size_t itime, const T& ftime) const
     {
       const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(index));
-      const float* vertices0 = (const float*) mesh->vertexPtr(0,itime+0);
-      const float* vertices1 = (const float*) mesh->vertexPtr(0,itime+1);
-      const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-      const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+      const Vec3fa v0 = mesh->vertexAtOffset(v[index],itime+0);
+      const Vec3fa v1 = mesh->vertexAtOffset(v[index],itime+1);
       const Vec3<T> p0(v0.x,v0.y,v0.z);
       const Vec3<T> p1(v1.x,v1.y,v1.z);
       return lerp(p0,p1,ftime);
@@ -104,16 +106,28 @@ namespace embree
 
       for (size_t mask=movemask(valid), i=bsf(mask); mask; mask=btc(mask,i), i=bsf(mask))
       {
-        const float* vertices0 = (const float*) mesh->vertexPtr(0,itime[i]+0);
-        const float* vertices1 = (const float*) mesh->vertexPtr(0,itime[i]+1);
-        const Vec3fa v0 = Vec3fa::loadu(vertices0+v[index]);
-        const Vec3fa v1 = Vec3fa::loadu(vertices1+v[index]);
+        const Vec3fa v0 = mesh->vertexAtOffset(v[index],itime[i]+0);
+        const Vec3fa v1 = mesh->vertexAtOffset(v[index],itime[i]+1);
         p0.x[i] = v0.x; p0.y[i] = v0.y; p0.z[i] = v0.z;
         p1.x[i] = v1.x; p1.y[i] = v1.y; p1.z[i] = v1.z;
       }
       return (T(one)-ftime)*p0 + ftime*p1;
     }
 
+    /* Gather the triangles one by one, decoding compressed vertex formats */
+    __forceinline void gatherCompressed(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2, const TriangleMesh* const* meshes, const vint<M>& itime) const
+    {
+      for (size_t i=0; i<M; i++)
+      {
+        const Vec3fa a = meshes[i]->vertexAtOffset(v0[i],itime[i]);
+        const Vec3fa b = meshes[i]->vertexAtOffset(v1[i],itime[i]);
+        const Vec3fa c = meshes[i]->vertexAtOffset(v2[i],itime[i]);
+        p0.x[i] = a.x; p0.y[i] = a.y; p0.z[i] = a.z;
+        p1.x[i] = b.x; p1.y[i] = b.y; p1.z[i] = b.z;
+        p2.x[i] = c.x; p2.y[i] = c.y; p2.z[i] = c.z;
+      }
+    }
+
     /* Gather the triangles */
     __forceinline void gather(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2, const Scene* const scene) const;
 
@@ -165,10 +179,10 @@ namespace embree
       BBox3fa bounds = empty;
       for (size_t i=0; i<M && valid(i); i++)
       {
-        const float* vertices = (const float*) scene->get<TriangleMesh>(geomID(i))->vertexPtr(0,itime);
-        bounds.extend(Vec3fa::loadu(vertices+v0[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v1[i]));
-        bounds.extend(Vec3fa::loadu(vertices+v2[i]));
+        const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID(i));
+        bounds.extend(mesh->vertexAtOffset(v0[i],itime));
+        bounds.extend(mesh->vertexAtOffset(v1[i],itime));
+        bounds.extend(mesh->vertexAtOffset(v2[i],itime));
       }
       return bounds;
     }
@@ -294,6 +308,12 @@ namespace embree
     const float* vertices1 = scene->vertices[geomID(1)];
     const float* vertices2 = scene->vertices[geomID(2)];
     const float* vertices3 = scene->vertices[geomID(3)];
+    if (unlikely(!vertices0 || !vertices1 || !vertices2 || !vertices3)) {
+      const TriangleMesh* meshes[4] = { scene->get<TriangleMesh>(geomID(0)), scene->get<TriangleMesh>(geomID(1)),
+                                        scene->get<TriangleMesh>(geomID(2)), scene->get<TriangleMesh>(geomID(3)) };
+      gatherCompressed(p0,p1,p2,meshes,vint4(zero));
+      return;
+    }
     const vfloat4 a0 = vfloat4::loadu(vertices0 + v0[0]);
     const vfloat4 a1 = vfloat4::loadu(vertices1 + v0[1]);
     const vfloat4 a2 = vfloat4::loadu(vertices2 + v0[2]);
@@ -321,6 +341,11 @@ namespace embree
                                            const TriangleMesh* mesh3,
                                            const vint4& itime) const
   {
+    if (unlikely(mesh0->compressedVertices() || mesh1->compressedVertices() || mesh2->compressedVertices() || mesh3->compressedVertices())) {
+      const TriangleMesh* meshes[4] = { mesh0, mesh1, mesh2, mesh3 };
+      gatherCompressed(p0,p1,p2,meshes,itime);
+      return;
+    }
     const float* vertices0 = (const float*) mesh0->vertexPtr(0,itime[0]);
     const float* vertices1 = (const float*) mesh1->vertexPtr(0,itime[1]);
     const float* vertices2 = (const float*) mesh2->vertexPtr(0,itime[2]);
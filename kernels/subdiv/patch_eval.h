@@ -32,21 +32,21 @@ namespace embree
         typedef typename Patch::Ref Ref;
         typedef CatmullClarkPatchT<Vertex,Vertex_t> CatmullClarkPatch;
         
-        PatchEval (SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
+        PatchEval (SharedLazyTessellationCache& cache, SharedLazyTessellationCache::CacheEntry& entry, size_t commitCounter, 
                    const HalfEdge* edge, const char* vertices, size_t stride, const float u, const float v, 
                    Vertex* P, Vertex* dPdu, Vertex* dPdv, Vertex* ddPdudu, Vertex* ddPdvdv, Vertex* ddPdudv)
         : P(P), dPdu(dPdu), dPdv(dPdv), ddPdudu(ddPdudu), ddPdvdv(ddPdvdv), ddPdudv(ddPdudv)
         {
           /* conservative time for the very first allocation */
-          auto time = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
+          auto time = cache.getTime(commitCounter);
 
-          Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
-              auto alloc = [&](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          Ref patch = cache.lookup(entry,commitCounter,[&] () {
+              auto alloc = [&](size_t bytes) { return cache.malloc(bytes); };
               return Patch::create(alloc,edge,vertices,stride);
             },true);
 
-          auto curTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
-          const bool allAllocationsValid = SharedLazyTessellationCache::validTime(time,curTime);
+          auto curTime = cache.getTime(commitCounter);
+          const bool allAllocationsValid = cache.validTime(time,curTime);
 
           if (patch && allAllocationsValid &&  eval(patch,u,v,1.0f,0)) {
             SharedLazyTessellationCache::unlock();
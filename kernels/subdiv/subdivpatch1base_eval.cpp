@@ -74,6 +74,31 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
+    /* calls the displacement shader once for all N points of a grid */
+    __forceinline void displaceGrid(const SubdivPatch1Base& patch, const SubdivMesh* const geom,
+                                    const float* grid_u, const float* grid_v,
+                                    const float* grid_Ng_x, const float* grid_Ng_y, const float* grid_Ng_z,
+                                    float* grid_x, float* grid_y, float* grid_z,
+                                    const unsigned N)
+    {
+      RTCDisplacementFunctionNArguments args;
+      args.geometryUserPtr = geom->userPtr;
+      args.geometry = (RTCGeometry)geom;
+      //args.geomID = patch.geomID();
+      args.primID = patch.primID();
+      args.timeStep = patch.time();
+      args.u = grid_u;
+      args.v = grid_v;
+      args.Ng_x = grid_Ng_x;
+      args.Ng_y = grid_Ng_y;
+      args.Ng_z = grid_Ng_z;
+      args.P_x = grid_x;
+      args.P_y = grid_y;
+      args.P_z = grid_z;
+      args.N = N;
+      geom->displFunc(&args);
+    }
+
     /* eval grid over patch and stich edges when required */      
     void evalGrid(const SubdivPatch1Base& patch,
                   const unsigned x0, const unsigned x1,
@@ -136,24 +161,8 @@ namespace embree
         }
 
         /* call displacement shader */
-        if (unlikely(geom->displFunc)) {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
-        }
+        if (unlikely(geom->displFunc))
+          displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
 
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
@@ -188,38 +197,48 @@ namespace embree
           stitchUVGrid(patch.level,swidth,sheight,x0,y0,dwidth,dheight,grid_u,grid_v);
       
         /* iterates over all grid points */
+        const bool displ = geom->displFunc;
+        const unsigned N = displ ? M : 0;
+        dynamic_large_stack_array(float,grid_Ng_x,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_y,N,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_z,N,32*32*sizeof(float));
+
         for (unsigned i=0; i<grid_size_simd_blocks; i++)
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
           Vec3vfx vtx = patchEval(patch,u,v);
         
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
+          /* store normals for displacement function */
+          if (unlikely(displ))
           {
             const Vec3vfx normal = normalize_safe(patchNormal(patch, u, v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
+            vfloatx::store(&grid_Ng_x[i*VSIZEX],normal.x);
+            vfloatx::store(&grid_Ng_y[i*VSIZEX],normal.y);
+            vfloatx::store(&grid_Ng_z[i*VSIZEX],normal.z);
           }
 
           vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
           vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
           vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
         }
+
+        /* call displacement shader once for the entire grid */
+        if (unlikely(displ))
+        {
+          displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
+
+          /* set last elements in x,y,z array to last displaced point */
+          const float last_x = grid_x[dwidth*dheight-1];
+          const float last_y = grid_y[dwidth*dheight-1];
+          const float last_z = grid_z[dwidth*dheight-1];
+          for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+          {
+            grid_x[i] = last_x;
+            grid_y[i] = last_y;
+            grid_z[i] = last_z;
+          }
+        }
       }
     }
 
@@ -272,24 +291,7 @@ namespace embree
 
         /* call displacement shader */
         if (unlikely(geom->displFunc))
-        {
-          RTCDisplacementFunctionNArguments args;
-          args.geometryUserPtr = geom->userPtr;
-          args.geometry = (RTCGeometry)geom;
-          //args.geomID = patch.geomID();
-          args.primID = patch.primID();
-          args.timeStep = patch.time();
-          args.u = grid_u;
-          args.v = grid_v;
-          args.Ng_x = grid_Ng_x;
-          args.Ng_y = grid_Ng_y;
-          args.Ng_z = grid_Ng_z;
-          args.P_x = grid_x;
-          args.P_y = grid_y;
-          args.P_z = grid_z;
-          args.N = dwidth*dheight;
-          geom->displFunc(&args);
-        }
+          displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
 
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
@@ -364,32 +366,32 @@ namespace embree
         bounds_max[1] = neg_inf;
         bounds_max[2] = neg_inf;
 
+        const bool displ = geom->displFunc;
+        const unsigned N = displ ? M : 0;
+        dynamic_large_stack_array(float,grid_x,N,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,N,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,N,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_x,N,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_y,N,64*64*sizeof(float));
+        dynamic_large_stack_array(float,grid_Ng_z,N,64*64*sizeof(float));
+
         for (unsigned i=0; i<grid_size_simd_blocks; i++)
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
           Vec3vfx vtx = patchEval(patch,u,v);
         
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
+          /* store points and normals for displacement function */
+          if (unlikely(displ))
           {
             const Vec3vfx normal = normalize_safe(patchNormal(patch,u,v));
-            RTCDisplacementFunctionNArguments args;
-            args.geometryUserPtr = geom->userPtr;
-            args.geometry = (RTCGeometry)geom;
-            //args.geomID = patch.geomID();
-            args.primID = patch.primID();
-            args.timeStep = patch.time();
-            args.u = &u[0];
-            args.v = &v[0];
-            args.Ng_x = &normal.x[0];
-            args.Ng_y = &normal.y[0];
-            args.Ng_z = &normal.z[0];
-            args.P_x = &vtx.x[0];
-            args.P_y = &vtx.y[0];
-            args.P_z = &vtx.z[0];
-            args.N = VSIZEX;
-            geom->displFunc(&args);
+            vfloatx::store(&grid_Ng_x[i*VSIZEX],normal.x);
+            vfloatx::store(&grid_Ng_y[i*VSIZEX],normal.y);
+            vfloatx::store(&grid_Ng_z[i*VSIZEX],normal.z);
+            vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
+            vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
+            vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
+            continue;
           }
 
           bounds_min[0] = min(bounds_min[0],vtx.x);
@@ -400,6 +402,33 @@ namespace embree
           bounds_max[2] = max(bounds_max[2],vtx.z);      
         }
 
+        /* call displacement shader once for the entire grid and bound displaced points */
+        if (unlikely(displ))
+        {
+          displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
+
+          const float last_x = grid_x[dwidth*dheight-1];
+          const float last_y = grid_y[dwidth*dheight-1];
+          const float last_z = grid_z[dwidth*dheight-1];
+          for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+          {
+            grid_x[i] = last_x;
+            grid_y[i] = last_y;
+            grid_z[i] = last_z;
+          }
+
+          for (unsigned i=0; i<grid_size_simd_blocks; i++)
+          {
+            const Vec3vfx vtx(vfloatx::load(&grid_x[i*VSIZEX]),vfloatx::load(&grid_y[i*VSIZEX]),vfloatx::load(&grid_z[i*VSIZEX]));
+            bounds_min[0] = min(bounds_min[0],vtx.x);
+            bounds_max[0] = max(bounds_max[0],vtx.x);
+            bounds_min[1] = min(bounds_min[1],vtx.y);
+            bounds_max[1] = max(bounds_max[1],vtx.y);
+            bounds_min[2] = min(bounds_min[2],vtx.z);
+            bounds_max[2] = max(bounds_max[2],vtx.z);
+          }
+        }
+
         b.lower.x = reduce_min(bounds_min[0]);
         b.lower.y = reduce_min(bounds_min[1]);
         b.lower.z = reduce_min(bounds_min[2]);
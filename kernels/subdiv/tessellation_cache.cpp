@@ -18,55 +18,39 @@
 
 namespace embree
 {
-  SharedLazyTessellationCache SharedLazyTessellationCache::sharedLazyTessellationCache;
-
   __thread ThreadWorkState* SharedLazyTessellationCache::init_t_state = nullptr;
   ThreadWorkState* SharedLazyTessellationCache::current_t_state = nullptr;
+  ThreadWorkState SharedLazyTessellationCache::threadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+  std::atomic<size_t> SharedLazyTessellationCache::numRenderThreads(0);
+  SpinLock SharedLazyTessellationCache::linkedlist_mtx;
 
-  void resizeTessellationCache(size_t new_size)
-  {    
-    if (new_size >= SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE)
-      new_size = SharedLazyTessellationCache::MAX_TESSELLATION_CACHE_SIZE;
-    if (SharedLazyTessellationCache::sharedLazyTessellationCache.getSize() != new_size) 
-      SharedLazyTessellationCache::sharedLazyTessellationCache.realloc(new_size);    
-  }
-
-  void resetTessellationCache()
-  {
-    //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
-    SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
-  }
-  
-  SharedLazyTessellationCache::SharedLazyTessellationCache()
+  SharedLazyTessellationCache::SharedLazyTessellationCache(size_t bytes)
   {
-    size = 0;
+    size = min(bytes,MAX_TESSELLATION_CACHE_SIZE);
     data = nullptr;
     hugepages = false;
-    maxBlocks              = size/BLOCK_SIZE;
-    localTime              = NUM_CACHE_SEGMENTS;
+    if (size) data = (float*)os_malloc(size,hugepages);
+    maxBlocks = size/BLOCK_SIZE;
+
+    /* use many small segments to evict only a small fraction of the cache at once */
+    numSegments = max(min(size/MIN_CACHE_SEGMENT_SIZE,MAX_CACHE_SEGMENTS),MIN_CACHE_SEGMENTS);
+
+    localTime              = numSegments;
     next_block             = 0;
-    numRenderThreads       = 0;
 #if FORCE_SIMPLE_FLUSH == 1
     switch_block_threshold = maxBlocks;
 #else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
+    switch_block_threshold = maxBlocks/numSegments;
 #endif
-    threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
-    //reset_state.reset();
-    //linkedlist_mtx.reset();
+    numHits = 0;
+    numMisses = 0;
+    numEvictions = 0;
   }
 
   SharedLazyTessellationCache::~SharedLazyTessellationCache() 
   {
-    for (ThreadWorkState* t=current_t_state; t!=nullptr; ) 
-    {
-      ThreadWorkState* next = t->next;
-      if (t->allocated) delete t;
-      t = next;
-    }
-
-    delete[] threadWorkState;
+    if (data) os_free(data,size,hugepages);
   }
 
   void SharedLazyTessellationCache::getNextRenderThreadWorkState() 
@@ -111,19 +95,18 @@ namespace embree
         
         /* switch to the next segment */
         addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
         
 #if FORCE_SIMPLE_FLUSH == 1
         next_block = 0;
         switch_block_threshold = maxBlocks;
 #else
-        const size_t region = localTime % NUM_CACHE_SEGMENTS;
-        next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-        switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
+        const size_t region = localTime % numSegments;
+        next_block = region * (maxBlocks/numSegments);
+        switch_block_threshold = next_block + (maxBlocks/numSegments);
         assert( switch_block_threshold <= maxBlocks );
 #endif
         
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
+        numEvictions++;
         
         /* release all blocked threads */
         
@@ -156,17 +139,17 @@ namespace embree
       if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
         waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
 
-    /* reset to the first segment */
-    next_block = 0;
+    /* invalidate entire cache and continue with the next segment */
+    localTime += numSegments;
 #if FORCE_SIMPLE_FLUSH == 1
+    next_block = 0;
     switch_block_threshold = maxBlocks;
 #else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
+    const size_t region = localTime % numSegments;
+    next_block = region * (maxBlocks/numSegments);
+    switch_block_threshold = next_block + (maxBlocks/numSegments);
 #endif
 
-    /* reset local time */
-    localTime = NUM_CACHE_SEGMENTS;
-
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
       unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
@@ -178,82 +161,20 @@ namespace embree
     reset_state.unlock();
   }
 
-  void SharedLazyTessellationCache::realloc(const size_t new_size)
+  void SharedLazyTessellationCache::printStats()
   {
-    /* lock the reset_state */
-    reset_state.lock();
-
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-
-    /* reallocate data */
-    if (data) os_free(data,size,hugepages);
-    size      = new_size;
-    data      = nullptr;
-    if (size) data = (float*)os_malloc(size,hugepages);
-    maxBlocks = size/BLOCK_SIZE;    
-
-    /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
-
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
-
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
-
-    /* unlock the reset_state */
-    reset_state.unlock();
+    PRINT(size);
+    PRINT(numSegments);
+    PRINT(numHits);
+    PRINT(numMisses);
+    PRINT(numEvictions);
+    PRINT(100.0f * numHits / max(size_t(1),numHits+numMisses));
   }
 
-
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
-
-  void SharedTessellationCacheStats::printStats()
-  {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
-  }
-
-  void SharedTessellationCacheStats::clearStats()
-  {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
-  }
-
   struct cache_regression_test : public RegressionTest
   {
     BarrierSys barrier;
@@ -261,9 +182,10 @@ namespace embree
     std::atomic<int> threadIDCounter;
     static const size_t numEntries = 4*1024;
     SharedLazyTessellationCache::CacheEntry entry[numEntries];
+    SharedLazyTessellationCache* cache;
 
     cache_regression_test() 
-      : RegressionTest("cache_regression_test"), numFailed(0), threadIDCounter(0)
+      : RegressionTest("cache_regression_test"), numFailed(0), threadIDCounter(0), cache(nullptr)
     {
       registerRegressionTest(this);
     }
@@ -271,7 +193,8 @@ namespace embree
     static void thread_alloc(cache_regression_test* This)
     {
       int threadID = This->threadIDCounter++;
-      size_t maxN = SharedLazyTessellationCache::sharedLazyTessellationCache.maxAllocSize()/4;
+      SharedLazyTessellationCache& cache = *This->cache;
+      size_t maxN = cache.maxAllocSize()/4;
       This->barrier.wait();
 
       for (size_t j=0; j<100000; j++)
@@ -279,14 +202,14 @@ namespace embree
         size_t elt = (threadID+j)%numEntries;
         size_t N = min(1+10*(elt%1000),maxN);
           
-        volatile int* data = (volatile int*) SharedLazyTessellationCache::lookup(This->entry[elt],0,[&] () {
-            int* data = (int*) SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(4*N);
+        volatile int* data = (volatile int*) cache.lookup(This->entry[elt],0,[&] () {
+            int* data = (int*) cache.malloc(4*N);
             for (size_t k=0; k<N; k++) data[k] = (int)elt;
             return data;
           });
         
         if (data == nullptr) {
-          SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+          SharedLazyTessellationCache::unlock();
           This->numFailed++;
           continue;
         }
@@ -299,7 +222,7 @@ namespace embree
           }
         }
         
-        SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+        SharedLazyTessellationCache::unlock();
       }
       This->barrier.wait();
     }
@@ -307,6 +230,10 @@ namespace embree
     bool run ()
     {
       numFailed.store(0);
+      threadIDCounter.store(0);
+      for (size_t i=0; i<numEntries; i++)
+        entry[i].tag.reset();
+      cache = new SharedLazyTessellationCache(16*1024*1024);
 
       size_t numThreads = getNumberOfLogicalThreads();
       barrier.init(numThreads+1);
@@ -324,16 +251,11 @@ namespace embree
       for (size_t i=0; i<numThreads; i++)
         join(threads[i]);
 
+      delete cache; cache = nullptr;
+
       return numFailed == 0;
     }
   };
 
   cache_regression_test cache_regression;
 };
-
-extern "C" void printTessCacheStats()
-{
-  PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
-}
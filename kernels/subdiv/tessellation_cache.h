@@ -23,33 +23,8 @@
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
-  {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
-  };
-  
-  void resizeTessellationCache(size_t new_size);
-  void resetTessellationCache();
-  
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -69,11 +44,21 @@ namespace embree
    }   
  };
 
+ /*! Lazy tessellation cache with an explicit byte budget. Each device
+  *  owns its own cache instance, thus scenes of different devices do
+  *  not evict each other. The memory is split into segments that are
+  *  filled as a ring buffer, when the cache is full only the oldest
+  *  segment gets evicted. The per thread states used to synchronize
+  *  segment evictions are shared between all cache instances. */
  class __aligned(64) SharedLazyTessellationCache 
  {
+   ALIGNED_CLASS_(64);
+
  public:
    
-   static const size_t NUM_CACHE_SEGMENTS              = 8;
+   static const size_t MIN_CACHE_SEGMENTS              = 8;
+   static const size_t MAX_CACHE_SEGMENTS              = 64;
+   static const size_t MIN_CACHE_SEGMENT_SIZE          = 1024*1024;
    static const size_t NUM_PREALLOC_THREAD_WORK_STATES = 512;
    static const size_t COMMIT_INDEX_SHIFT              = 32+8;
 #if defined(__X86_64__)
@@ -93,7 +78,7 @@ namespace embree
    {
      if (unlikely(!init_t_state))
        /* sets init_t_state, can't return pointer due to macosx icc bug*/
-       SharedLazyTessellationCache::sharedLazyTessellationCache.getNextRenderThreadWorkState();
+       SharedLazyTessellationCache::getNextRenderThreadWorkState();
      return init_t_state;
    }
 
@@ -101,22 +86,22 @@ namespace embree
    {
      __forceinline Tag() : data(0) {}
 
-     __forceinline Tag(void* ptr, size_t combinedTime) { 
-       init(ptr,combinedTime);
+     __forceinline Tag(void* ptr, size_t combinedTime, const void* base) { 
+       init(ptr,combinedTime,base);
      }
 
-     __forceinline Tag(size_t ptr, size_t combinedTime) {
-       init((void*)ptr,combinedTime); 
+     __forceinline Tag(size_t ptr, size_t combinedTime, const void* base) {
+       init((void*)ptr,combinedTime,base);
      }
 
-     __forceinline void init(void* ptr, size_t combinedTime)
+     __forceinline void init(void* ptr, size_t combinedTime, const void* base)
      {
        if (ptr == nullptr) {
          data = 0;
          return;
        }
        int64_t new_root_ref = (int64_t) ptr;
-       new_root_ref -= (int64_t)SharedLazyTessellationCache::sharedLazyTessellationCache.getDataPtr();                                
+       new_root_ref -= (int64_t) base;
        assert( new_root_ref <= (int64_t)REF_TAG_MASK );
        new_root_ref |= (int64_t)combinedTime << COMMIT_INDEX_SHIFT; 
        data = new_root_ref;
@@ -144,23 +129,30 @@ namespace embree
    bool hugepages;
    size_t size;
    size_t maxBlocks;
-   ThreadWorkState *threadWorkState;
+   size_t numSegments;
       
    __aligned(64) std::atomic<size_t> localTime;
    __aligned(64) std::atomic<size_t> next_block;
    __aligned(64) SpinLock   reset_state;
-   __aligned(64) SpinLock   linkedlist_mtx;
    __aligned(64) std::atomic<size_t> switch_block_threshold;
-   __aligned(64) std::atomic<size_t> numRenderThreads;
 
+   static ThreadWorkState threadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+   static std::atomic<size_t> numRenderThreads;
+   static SpinLock linkedlist_mtx;
 
  public:
 
+   /*! cache statistics */
+   __aligned(64) std::atomic<size_t> numHits;      //!< number of lookups that found a valid entry
+   __aligned(64) std::atomic<size_t> numMisses;    //!< number of entries that had to get (re-)created
+   __aligned(64) std::atomic<size_t> numEvictions; //!< number of segments evicted to make room for new entries
+
+ public:
       
-   SharedLazyTessellationCache();
+   SharedLazyTessellationCache(size_t bytes);
    ~SharedLazyTessellationCache();
 
-   void getNextRenderThreadWorkState();
+   static void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
      return switch_block_threshold;
@@ -170,92 +162,87 @@ namespace embree
    __forceinline void   addCurrentIndex(const size_t i=1) { localTime.fetch_add(i); }
 
    __forceinline size_t getTime(const size_t globalTime) {
-     return localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
+     return localTime.load()+numSegments*globalTime;
    }
 
 
-   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
-   __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
+   static __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
+   static __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
 
-   __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
+   static __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
 
-   static __forceinline void lock  () { sharedLazyTessellationCache.lockThread(threadState()); }
-   static __forceinline void unlock() { sharedLazyTessellationCache.unlockThread(threadState()); }
-   static __forceinline bool isLocked() { return sharedLazyTessellationCache.isLocked(threadState()); }
+   static __forceinline void lock  () { lockThread(threadState()); }
+   static __forceinline void unlock() { unlockThread(threadState()); }
+   static __forceinline bool isLocked() { return isLocked(threadState()); }
    static __forceinline size_t getState() { return threadState()->counter.load(); }
-   static __forceinline void lockThreadLoop() { sharedLazyTessellationCache.lockThreadLoop(threadState()); }
-
-   static __forceinline size_t getTCacheTime(const size_t globalTime) {
-     return sharedLazyTessellationCache.getTime(globalTime);
-   }
+   static __forceinline void lockThreadLoop() { lockThreadLoop(threadState()); }
 
    /* per thread lock */
-   __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
+   static __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
    { 
      while(1)
      {
-       size_t lock = SharedLazyTessellationCache::sharedLazyTessellationCache.lockThread(t_state,1);
+       size_t lock = lockThread(t_state,1);
        if (unlikely(lock >= THREAD_BLOCK_ATOMIC_ADD))
        {
          /* lock failed wait until sync phase is over */
-         sharedLazyTessellationCache.unlockThread(t_state,-1);	       
-         sharedLazyTessellationCache.waitForUsersLessEqual(t_state,0);
+         unlockThread(t_state,-1);	       
+         waitForUsersLessEqual(t_state,0);
        }
        else
          break;
      }
    }
 
-   static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
+   __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
+       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)getDataPtr();
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
+       if (likely( validCacheIndex(subdiv_patch_cache_index,globalTime) ))
        {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
+         numHits.fetch_add(1,std::memory_order_relaxed);
          return (void*) subdiv_patch_root;
        }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
      while (true)
      {
-       sharedLazyTessellationCache.lockThreadLoop(t_state);
-       void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
+       lockThreadLoop(t_state);
+       void* patch = lookup(entry,globalTime);
        if (patch) return (decltype(constructor())) patch;
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           numMisses.fetch_add(1,std::memory_order_relaxed);
+           auto timeBefore = getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
+           auto timeAfter = getTime(globalTime);
            auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           entry.tag = SharedLazyTessellationCache::Tag(ret,time,getDataPtr());
            __memory_barrier();
            entry.mutex.unlock();
            return ret;
          }
          entry.mutex.unlock();
        }
-       SharedLazyTessellationCache::sharedLazyTessellationCache.unlockThread(t_state);
+       unlockThread(t_state);
      }
    }
    
@@ -264,26 +251,26 @@ namespace embree
 #if FORCE_SIMPLE_FLUSH == 1
      return i == getTime(globalTime);
 #else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
+     return i+(numSegments-1) >= getTime(globalTime);
 #endif
    }
 
-   static __forceinline bool validTime(const size_t oldtime, const size_t newTime)
+   __forceinline bool validTime(const size_t oldtime, const size_t newTime)
    {
-     return oldtime+(NUM_CACHE_SEGMENTS-1) >= newTime;
+     return oldtime+(numSegments-1) >= newTime;
    }
 
 
-    static __forceinline bool validTag(const Tag& tag, size_t globalTime)
+    __forceinline bool validTag(const Tag& tag, size_t globalTime)
     {
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      return validCacheIndex(subdiv_patch_cache_index,globalTime);
     }
 
-   void waitForUsersLessEqual(ThreadWorkState *const t_state,
-			      const unsigned int users);
+   static void waitForUsersLessEqual(ThreadWorkState *const t_state,
+                                     const unsigned int users);
     
    __forceinline size_t alloc(const size_t blocks)
    {
@@ -296,23 +283,23 @@ namespace embree
      return index;
    }
 
-   static __forceinline void* malloc(const size_t bytes)
+   __forceinline void* malloc(const size_t bytes)
    {
      size_t block_index = -1;
      ThreadWorkState *const t_state = threadState();
      while (true)
      {
-       block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
+       block_index = alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
-         sharedLazyTessellationCache.allocNextSegment();
-         sharedLazyTessellationCache.lockThread(t_state);
+         unlockThread(t_state);		  
+         allocNextSegment();
+         lockThread(t_state);
          continue; 
        }
        break;
      }
-     return sharedLazyTessellationCache.getBlockPtr(block_index);
+     return getBlockPtr(block_index);
    }
 
    __forceinline void *getBlockPtr(const size_t block_index)
@@ -327,12 +314,13 @@ namespace embree
    __forceinline size_t getNumUsedBytes() { return next_block * BLOCK_SIZE; }
    __forceinline size_t getMaxBlocks()    { return maxBlocks; }
    __forceinline size_t getSize()         { return size; }
+   __forceinline size_t getNumSegments()  { return numSegments; }
 
    void allocNextSegment();
-   void realloc(const size_t newSize);
 
    void reset();
 
-   static SharedLazyTessellationCache sharedLazyTessellationCache;
+   /*! prints cache statistics for debugging */
+   void printStats();
  };
 }
@@ -24,6 +24,7 @@ namespace embree {
   static const MAYBE_UNUSED size_t iterations_dynamic_dynamic    = 200;
   static const MAYBE_UNUSED size_t iterations_dynamic_static     = 50;
   static const MAYBE_UNUSED size_t iterations_static_static      = 30;
+  static const MAYBE_UNUSED size_t iterations_thread_scaling     = 10;
 
   extern "C" ISPCScene* g_ispc_scene;
 
@@ -305,6 +306,65 @@ namespace embree {
     g_scene = nullptr;
   }
 
+  void Benchmark_Static_Create_Scaling(ISPCScene* scene_in, const std::string& cfg, size_t benchmark_iterations, RTCBuildQuality quality, RTCBuildQuality qflags)
+  {
+    assert(g_scene == nullptr);
+    size_t primitives = getNumPrimitives(scene_in);
+    size_t objects = getNumObjects(scene_in);
+
+    /* the tasking system runs with the maximal number of threads of all devices, thus release the default device */
+    rtcReleaseDevice(g_device);
+
+    /* measure with 1, 2, 4, ... threads up to all hardware threads */
+    std::vector<size_t> threadCounts;
+    const size_t maxThreads = getNumberOfLogicalThreads();
+    for (size_t threads=1; threads<maxThreads; threads*=2)
+      threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    double time1 = 0.0;
+    for (size_t threads : threadCounts)
+    {
+      g_device = rtcNewDevice((cfg+",threads="+toString(threads)).c_str());
+      rtcSetDeviceErrorFunction(g_device,error_handler,nullptr);
+
+      size_t iterations = 0;
+      double time = 0.0;
+      for(size_t i=0;i<benchmark_iterations+skip_iterations;i++)
+      {
+        g_scene = createScene(RTC_SCENE_FLAG_NONE,qflags);
+        convertScene(g_scene,scene_in,quality);
+
+        double t0 = getSeconds();
+        rtcCommitScene (g_scene);
+        double t1 = getSeconds();
+        if (i >= skip_iterations)
+        {
+          time += t1 - t0;
+          iterations++;
+        }
+        rtcReleaseScene (g_scene);
+      }
+      time /= iterations;
+      if (threads == 1) time1 = time;
+
+      std::cout << "BENCHMARK_SCALING_CREATE_STATIC_STATIC "
+                << threads << " threads, "
+                << primitives << " primitives, " << objects << " objects, "
+                << time << " s, "
+                << 1.0 / time * primitives / 1000000.0 << " Mprims/s, "
+                << time1 / time << "x speedup, "
+                << 100.0 * time1 / time / threads << "% efficiency" << std::endl;
+
+      rtcReleaseDevice(g_device);
+    }
+
+    /* restore the default device */
+    g_device = rtcNewDevice(cfg.c_str());
+    rtcSetDeviceErrorFunction(g_device,error_handler,nullptr);
+    g_scene = nullptr;
+  }
+
   void Pause()
   {
     std::cout << "sleeping..." << std::flush;
@@ -332,6 +392,8 @@ namespace embree {
     Benchmark_Static_Create(g_ispc_scene,iterations_static_static,RTC_BUILD_QUALITY_MEDIUM,RTC_BUILD_QUALITY_MEDIUM);
     Pause();
     Benchmark_Static_Create(g_ispc_scene,iterations_static_static,RTC_BUILD_QUALITY_MEDIUM,RTC_BUILD_QUALITY_HIGH);
+    Pause();
+    Benchmark_Static_Create_Scaling(g_ispc_scene,cfg,iterations_thread_scaling,RTC_BUILD_QUALITY_MEDIUM,RTC_BUILD_QUALITY_MEDIUM);
   }
 
   /* called by the C++ code to render */
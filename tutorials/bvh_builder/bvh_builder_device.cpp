@@ -114,7 +114,7 @@ namespace embree
     /* settings for BVH build */
     RTCBuildArguments arguments = rtcDefaultBuildArguments();
     arguments.byteSize = sizeof(arguments);
-    arguments.buildFlags = RTC_BUILD_FLAG_DYNAMIC;
+    arguments.buildFlags = (RTCBuildFlags) (RTC_BUILD_FLAG_DYNAMIC | RTC_BUILD_FLAG_REFIT);
     arguments.buildQuality = quality;
     arguments.maxBranchingFactor = 2;
     arguments.maxDepth = 1024;
@@ -135,6 +135,7 @@ namespace embree
     arguments.buildProgress = buildProgress;
     arguments.userPtr = nullptr;
     
+    Node* root = nullptr;
     for (size_t i=0; i<10; i++)
     {
       /* we recreate the prims array here, as the builders modify this array */
@@ -142,12 +143,26 @@ namespace embree
 
       std::cout << "iteration " << i << ": building BVH over " << prims.size() << " primitives, " << std::flush;
       double t0 = getSeconds();
-      Node* root = (Node*) rtcBuildBVH(&arguments);
+      root = (Node*) rtcBuildBVH(&arguments);
       double t1 = getSeconds();
       const float sah = root ? root->sah() : 0.0f;
       std::cout << 1000.0f*(t1-t0) << "ms, " << 1E-6*double(prims.size())/(t1-t0) << " Mprims/s, sah = " << sah << " [DONE]" << std::endl;
     }
 
+    /* move all primitives and refit the BVH, the builder reordered the prims array */
+    if (root)
+    {
+      for (size_t j=0; j<prims.size(); j++) {
+        prims[j].upper_x += 10.0f;
+        prims[j].upper_y += 10.0f;
+      }
+      std::cout << "refitting BVH over " << prims.size() << " primitives, " << std::flush;
+      double t0 = getSeconds();
+      rtcRefitBVH(bvh,prims.data(),InnerNode::setBounds,nullptr);
+      double t1 = getSeconds();
+      std::cout << 1000.0f*(t1-t0) << "ms, " << 1E-6*double(prims.size())/(t1-t0) << " Mprims/s, sah = " << root->sah() << " [DONE]" << std::endl;
+    }
+
     rtcReleaseBVH(bvh);
   }
 
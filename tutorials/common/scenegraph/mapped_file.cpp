@@ -0,0 +1,93 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "mapped_file.h"
+
+#if defined(__WIN32__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace embree
+{
+#if defined(__WIN32__)
+
+  MappedFile::MappedFile (const FileName& fileName)
+    : ptr(nullptr), bytes(0), file(INVALID_HANDLE_VALUE), mapping(nullptr)
+  {
+    file = CreateFileA(fileName.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_FLAG_SEQUENTIAL_SCAN,nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file,&fileSize)) {
+      CloseHandle(file);
+      THROW_RUNTIME_ERROR("cannot get size of " + fileName.str());
+    }
+    bytes = size_t(fileSize.QuadPart);
+    if (bytes == 0) return;
+
+    mapping = CreateFileMappingA(file,nullptr,PAGE_READONLY,0,0,nullptr);
+    if (mapping) ptr = (char*) MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+    if (ptr == nullptr) {
+      if (mapping) CloseHandle(mapping);
+      CloseHandle(file);
+      THROW_RUNTIME_ERROR("cannot map " + fileName.str());
+    }
+  }
+
+  MappedFile::~MappedFile ()
+  {
+    if (ptr) UnmapViewOfFile(ptr);
+    if (mapping) CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+  }
+
+#else
+
+  MappedFile::MappedFile (const FileName& fileName)
+    : ptr(nullptr), bytes(0)
+  {
+    int fd = open(fileName.c_str(),O_RDONLY);
+    if (fd == -1)
+      THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+
+    struct stat st;
+    if (fstat(fd,&st) == -1) {
+      close(fd);
+      THROW_RUNTIME_ERROR("cannot get size of " + fileName.str());
+    }
+    bytes = size_t(st.st_size);
+    if (bytes == 0) { close(fd); return; }
+
+    void* p = mmap(nullptr,bytes,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);
+    if (p == MAP_FAILED)
+      THROW_RUNTIME_ERROR("cannot map " + fileName.str());
+    ptr = (char*) p;
+  }
+
+  MappedFile::~MappedFile () {
+    if (ptr) munmap(ptr,bytes);
+  }
+
+#endif
+}
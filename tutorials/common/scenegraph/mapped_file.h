@@ -0,0 +1,52 @@
+// ======================================================================== //
+// Copyright 2009-2018 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "../default.h"
+
+namespace embree
+{
+  /*! read-only memory mapping of a file */
+  class MappedFile : public RefCount
+  {
+  public:
+
+    /*! maps the file into memory, throws if the file cannot get mapped */
+    MappedFile (const FileName& fileName);
+
+    /*! unmaps the file */
+    ~MappedFile ();
+
+    /*! returns pointer to the first byte of the file */
+    __forceinline const char* data() const { return ptr; }
+
+    /*! returns the size of the file in bytes */
+    __forceinline size_t size() const { return bytes; }
+
+  private:
+    MappedFile (const MappedFile& other) DELETED; // do not implement
+    MappedFile& operator= (const MappedFile& other) DELETED; // do not implement
+
+  private:
+    char* ptr;       //!< start of the mapped file
+    size_t bytes;    //!< size of the mapped file
+#if defined(__WIN32__)
+    void* file;      //!< file handle
+    void* mapping;   //!< file mapping handle
+#endif
+  };
+}
@@ -15,7 +15,9 @@
 // ======================================================================== //
 
 #include "obj_loader.h"
+#include "mapped_file.h"
 #include "texture.h"
+#include "../../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -112,6 +114,60 @@ namespace embree
     return Vec3fa(x,y,z);
   }
 
+  /*! Returns the end of the line starting at cur. */
+  static inline const char* findEndOfLine(const char* cur, const char* end) {
+    const char* eol = (const char*) memchr(cur, '\n', end-cur);
+    return eol ? eol : end;
+  }
+
+  /*! Read next line from a buffer, joins lines that end with a backslash. */
+  static inline bool getLine(const char*& cur, const char* end, std::string& line)
+  {
+    if (cur >= end) return false;
+    const char* eol = findEndOfLine(cur,end);
+    line.assign(cur,eol);
+    cur = eol < end ? eol+1 : end;
+    while (!line.empty() && line[line.size()-1] == '\\') {
+      line[line.size()-1] = ' ';
+      if (cur >= end) break;
+      eol = findEndOfLine(cur,end);
+      if (eol == cur) { cur = eol < end ? eol+1 : end; break; }
+      line.append(cur,eol);
+      cur = eol < end ? eol+1 : end;
+    }
+    return true;
+  }
+
+  /*! Splits the buffer into blocks of about blockSize bytes that start at the beginning of a line. */
+  static std::vector<const char*> splitIntoBlocks(const char* begin, const char* end, size_t blockSize)
+  {
+    std::vector<const char*> blocks;
+    blocks.push_back(begin);
+    const char* cur = begin;
+    while (size_t(end-cur) > blockSize)
+    {
+      /* do not split inside lines that continue on the next line */
+      cur = findEndOfLine(cur+blockSize,end);
+      while (cur < end && cur[-1] == '\\') cur = findEndOfLine(cur+1,end);
+      if (cur >= end) break;
+      blocks.push_back(++cur);
+    }
+    blocks.push_back(end);
+    return blocks;
+  }
+
+  /*! Vertex attributes defined at the start of a line. */
+  enum AttributeType { POSITION, NORMAL, TEXCOORD, NO_ATTRIBUTE };
+
+  static inline AttributeType getAttributeType(const char* token)
+  {
+    if (token[0] != 'v') return NO_ATTRIBUTE;
+    if (isSep(token[1])) return POSITION;
+    if (token[1] == 'n' && isSep(token[2])) return NORMAL;
+    if (token[1] == 't' && isSep(token[2])) return TEXCOORD;
+    return NO_ATTRIBUTE;
+  }
+
   class OBJLoader
   {
   public:
@@ -130,6 +186,9 @@ namespace embree
     /*! load only quads and ignore triangles */
     bool subdivMode;
 
+    /*! Number of vertex attributes parsed so far, relative indices refer to these. */
+    size_t numV, numVN, numVT;
+
     /*! Geometry buffer. */
     avector<Vec3fa> v;
     avector<Vec3fa> vn;
@@ -146,6 +205,7 @@ namespace embree
     std::map<std::string, std::shared_ptr<Texture>> textureMap; 
 
   private:
+    void loadVertexAttributes(const char* begin, const char* end);
     void loadMTL(const FileName& fileName);
     unsigned int fix_v (int index);
     unsigned int fix_vt(int index);
@@ -159,48 +219,35 @@ namespace embree
   };
 
   OBJLoader::OBJLoader(const FileName &fileName, const bool subdivMode, const bool combineIntoSingleObject) 
-    : group(new SceneGraph::GroupNode), path(fileName.path()), subdivMode(subdivMode)
+    : group(new SceneGraph::GroupNode), path(fileName.path()), subdivMode(subdivMode), numV(0), numVN(0), numVT(0)
   {
-    /* open file */
-    std::ifstream cin;
-    cin.open(fileName.c_str());
-    if (!cin.is_open()) {
-      THROW_RUNTIME_ERROR("cannot open " + fileName.str());
-      return;
-    }
+    /* map file into memory */
+    Ref<MappedFile> file = new MappedFile(fileName);
+    const char* begin = file->data();
+    const char* end = begin + file->size();
+
+    /* parse all vertex attributes in parallel */
+    loadVertexAttributes(begin,end);
 
     /* generate default material */
     Ref<SceneGraph::MaterialNode> defaultMaterial = new OBJMaterial("default");
     curMaterialName = "default";
     curMaterial = defaultMaterial;
 
-    while (cin.peek() != -1)
+    std::string line;
+    for (const char* cur = begin; getLine(cur,end,line); )
     {
-      /* load next multiline */
-      std::string line; std::getline(cin,line);
-      while (!line.empty() && line[line.size()-1] == '\\') {
-	line[line.size()-1] = ' ';
-	std::string next_line; std::getline(cin,next_line);
-	if (next_line.empty()) break;
-	line += next_line;
-      }
       const char* token = trimEnd(line.c_str() + strspn(line.c_str(), " \t"));
       if (token[0] == 0) continue;
 
-      /*! parse position */
-      if (token[0] == 'v' && isSep(token[1])) { 
-        v.push_back(getVec3f(token += 2)); continue;
+      /*! skip already parsed vertex attributes */
+      switch (getAttributeType(token)) {
+      case POSITION: numV++;  continue;
+      case NORMAL  : numVN++; continue;
+      case TEXCOORD: numVT++; continue;
+      default      : break;
       }
 
-      /* parse normal */
-      if (token[0] == 'v' && token[1] == 'n' && isSep(token[2])) { 
-        vn.push_back(getVec3f(token += 3)); 
-        continue; 
-      }
-
-      /* parse texcoord */
-      if (token[0] == 'v' && token[1] == 't' && isSep(token[2])) { vt.push_back(getVec2f(token += 3)); continue; }
-
       /*! parse face */
       if (token[0] == 'f' && isSep(token[1]))
       {
@@ -285,8 +332,61 @@ namespace embree
       // ignore unknown stuff
     }
     flushFaceGroup();
+  }
 
-    cin.close();
+  /*! Parses positions, normals, and texture coordinates of the file in parallel. */
+  void OBJLoader::loadVertexAttributes(const char* begin, const char* end)
+  {
+    const std::vector<const char*> blocks = splitIntoBlocks(begin,end,4*1024*1024);
+    const size_t numBlocks = blocks.size()-1;
+
+    /* count vertex attributes of each block */
+    std::vector<size_t> blockV(numBlocks+1,0), blockVN(numBlocks+1,0), blockVT(numBlocks+1,0);
+    parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r)
+    {
+      std::string line;
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        for (const char* cur = blocks[i]; getLine(cur,blocks[i+1],line); )
+        {
+          switch (getAttributeType(trimEnd(line.c_str() + strspn(line.c_str(), " \t")))) {
+          case POSITION: blockV [i]++; break;
+          case NORMAL  : blockVN[i]++; break;
+          case TEXCOORD: blockVT[i]++; break;
+          default      : break;
+          }
+        }
+      }
+    });
+
+    /* compute where each block stores its vertex attributes */
+    size_t sumV = 0, sumVN = 0, sumVT = 0;
+    for (size_t i=0; i<=numBlocks; i++) {
+      const size_t nV = blockV[i], nVN = blockVN[i], nVT = blockVT[i];
+      blockV[i] = sumV; blockVN[i] = sumVN; blockVT[i] = sumVT;
+      sumV += nV; sumVN += nVN; sumVT += nVT;
+    }
+    v.resize(sumV); vn.resize(sumVN); vt.resize(sumVT);
+
+    /* parse vertex attributes of each block */
+    parallel_for(size_t(0), numBlocks, [&](const range<size_t>& r)
+    {
+      std::string line;
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        size_t iV = blockV[i], iVN = blockVN[i], iVT = blockVT[i];
+        for (const char* cur = blocks[i]; getLine(cur,blocks[i+1],line); )
+        {
+          const char* token = trimEnd(line.c_str() + strspn(line.c_str(), " \t"));
+          switch (getAttributeType(token)) {
+          case POSITION: v [iV++]  = getVec3f(token += 2); break;
+          case NORMAL  : vn[iVN++] = getVec3f(token += 3); break;
+          case TEXCOORD: vt[iVT++] = getVec2f(token += 3); break;
+          default      : break;
+          }
+        }
+      }
+    });
   }
 
   struct ExtObjMaterial
@@ -468,9 +568,9 @@ namespace embree
   }
 
   /*! handles relative indices and starts indexing from 0 */
-  unsigned int OBJLoader::fix_v (int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) v .size() + index)); }
-  unsigned int OBJLoader::fix_vt(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vt.size() + index)); }
-  unsigned int OBJLoader::fix_vn(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) vn.size() + index)); }
+  unsigned int OBJLoader::fix_v (int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) numV  + index)); }
+  unsigned int OBJLoader::fix_vt(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) numVT + index)); }
+  unsigned int OBJLoader::fix_vn(int index) { return (index > 0 ? index - 1 : (index == 0 ? 0 : (int) numVN + index)); }
 
   /*! Parse differently formated triplets like: n0, n0/n1/n2, n0//n2, n0/n1.          */
   /*! All indices are converted to C-style (from 0). Missing entries are assigned -1. */
@@ -507,19 +607,19 @@ namespace embree
     const std::map<Vertex, uint32_t>::iterator& entry = vertexMap.find(i);
     if (entry != vertexMap.end()) return(entry->second);
     
-    if (i.v >= v.size()) std::cout << "WARNING: corrupted OBJ file" << std::endl;
+    if (i.v >= numV) std::cout << "WARNING: corrupted OBJ file" << std::endl;
     else mesh->positions[0].push_back(v[i.v]);
       
     if (i.vn != -1) {
       while (mesh->normals[0].size() < mesh->positions[0].size()) mesh->normals[0].push_back(zero); // some vertices might not had a normal
 
-      if (i.vn >= vn.size()) std::cout << "WARNING: corrupted OBJ file" << std::endl;
+      if (i.vn >= numVN) std::cout << "WARNING: corrupted OBJ file" << std::endl;
       else mesh->normals[0][mesh->positions[0].size()-1] = vn[i.vn];
     }
     if (i.vt != -1) {
       while (mesh->texcoords.size() < mesh->positions[0].size()) mesh->texcoords.push_back(zero); // some vertices might not had a texture coordinate
 
-      if (i.vt >= vt.size()) std::cout << "WARNING: corrupted OBJ file" << std::endl;
+      if (i.vt >= numVT) std::cout << "WARNING: corrupted OBJ file" << std::endl;
       else mesh->texcoords[mesh->positions[0].size()-1] = vt[i.vt];
     }
     return (vertexMap[i] = (unsigned int)(mesh->positions[0].size()) - 1);
@@ -541,12 +641,12 @@ namespace embree
       Ref<SceneGraph::SubdivMeshNode> mesh = new SceneGraph::SubdivMeshNode(curMaterial,1);
       group->add(mesh.cast<SceneGraph::Node>());
 
-      for (size_t i=0; i<v.size();  i++) mesh->positions[0].push_back(v[i]);
-      for (size_t i=0; i<vn.size(); i++) mesh->normals[0].push_back(vn[i]);
-      for (size_t i=0; i<vt.size(); i++) mesh->texcoords.push_back(vt[i]);
+      for (size_t i=0; i<numV;  i++) mesh->positions[0].push_back(v[i]);
+      for (size_t i=0; i<numVN; i++) mesh->normals[0].push_back(vn[i]);
+      for (size_t i=0; i<numVT; i++) mesh->texcoords.push_back(vt[i]);
       
       for (size_t i=0; i<ec.size(); ++i) {
-        assert(((size_t)ec[i].a < v.size()) && ((size_t)ec[i].b < v.size()));
+        assert(((size_t)ec[i].a < numV) && ((size_t)ec[i].b < numV));
         mesh->edge_creases.push_back(Vec2i(ec[i].a, ec[i].b));
         mesh->edge_crease_weights.push_back(ec[i].w);
       }
@@ -17,6 +17,7 @@
 #include "xml_loader.h"
 #include "xml_parser.h"
 #include "obj_loader.h"
+#include "mapped_file.h"
 
 namespace embree
 {
@@ -212,6 +213,16 @@ namespace embree
     std::map<std::string,Variant> m;
   };
 
+  /*! maps the file into memory, returns nullptr if that fails */
+  static Ref<MappedFile> mapFileOpt(const FileName& fileName)
+  {
+    try {
+      return new MappedFile(fileName);
+    } catch (const std::runtime_error&) {
+      return nullptr;
+    }
+  }
+
   class XMLLoader
   {
     struct SharedState {
@@ -271,6 +282,8 @@ namespace embree
   private:
     template<typename T> T load(const Ref<XML>& xml) { assert(false); return T(zero); }
     template<typename T> T load(const Ref<XML>& xml, const T& opt) { assert(false); return T(zero); }
+    size_t loadBinarySize(const Ref<XML>& xml);
+    const char* mapBinary(const Ref<XML>& xml, size_t bytes);
     template<typename Vector> Vector loadBinary(const Ref<XML>& xml);
 
     std::vector<float> loadFloatArray(const Ref<XML>& xml);
@@ -287,9 +300,9 @@ namespace embree
 
   private:
     FileName path;         //!< path to XML file
-    FILE* binFile;         //!< .bin file for reading binary data
-    FileName binFileName;  //!< name of the .bin file
-    size_t binFileSize;
+    Ref<MappedFile> binFile; //!< memory mapped .bin file for reading binary data
+    FileName binFileName;    //!< name of the .bin file
+    size_t binFileOffset;    //!< end of the last array read from the .bin file
 
   private:
     SharedState& state;
@@ -410,28 +423,40 @@ namespace embree
     }
   }
 
-  template<typename Vector>
-  Vector XMLLoader::loadBinary(const Ref<XML>& xml)
+  size_t XMLLoader::loadBinarySize(const Ref<XML>& xml)
+  {
+    size_t size = atol(xml->parm("size").c_str());
+    if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
+    return size;
+  }
+
+  const char* XMLLoader::mapBinary(const Ref<XML>& xml, size_t bytes)
   {
     if (!binFile) 
       THROW_RUNTIME_ERROR("cannot open file "+binFileName.str()+" for reading");
 
-    size_t ofs = atol(xml->parm("ofs").c_str());
-    fseek(binFile,long(ofs),SEEK_SET);
-
-    /* read size of array */
-    size_t size = atol(xml->parm("size").c_str());
-    if (size == 0) size = atol(xml->parm("num").c_str()); // version for BGF format
+    /* data without offset directly follows the previously read data */
+    size_t ofs = binFileOffset;
+    if (xml->parm("ofs") != "") ofs = atol(xml->parm("ofs").c_str());
 
     /* perform security check that we stay in the file */
-    if (ofs + size*sizeof(typename Vector::value_type) > binFileSize)
+    if (ofs + bytes > binFile->size())
       THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
 
-    /* read data from file */
-    Vector data(size);
-    if (size != fread(data.data(), sizeof(typename Vector::value_type), data.size(), binFile)) 
-      THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+    binFileOffset = ofs + bytes;
+    return binFile->data() + ofs;
+  }
+
+  template<typename Vector>
+  Vector XMLLoader::loadBinary(const Ref<XML>& xml)
+  {
+    const size_t size = loadBinarySize(xml);
+    const size_t bytes = size*sizeof(typename Vector::value_type);
 
+    /* copy data from the mapped file */
+    const char* src = mapBinary(xml,bytes);
+    Vector data(size);
+    if (bytes) memcpy((void*)data.data(), src, bytes);
     return data;
   }
 
@@ -493,9 +518,13 @@ namespace embree
     if (!xml) return avector<Vec3fa>();
 
     if (xml->parm("ofs") != "") {
-      std::vector<Vec3f> temp = loadBinary<std::vector<Vec3f>>(xml);
-      avector<Vec3fa> data; data.resize(temp.size());
-      for (size_t i=0; i<temp.size(); i++) data[i] = Vec3fa(temp[i]);
+      if (xml->parm("format") == "float4")
+        return loadBinary<avector<Vec3fa>>(xml);
+
+      const size_t size = loadBinarySize(xml);
+      const Vec3f* src = (const Vec3f*) mapBinary(xml,size*sizeof(Vec3f));
+      avector<Vec3fa> data; data.resize(size);
+      for (size_t i=0; i<size; i++) data[i] = Vec3fa(src[i]);
       return data;
     } 
     else 
@@ -719,12 +748,11 @@ namespace embree
       const unsigned height = stoi(xml->parm("height"));
       const Texture::Format format = Texture::string_to_format(xml->parm("format"));
       const unsigned bytesPerTexel = Texture::getFormatBytesPerTexel(format);
-      if (ftell(binFile) + width*height*bytesPerTexel > (unsigned)binFileSize)
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      const size_t bytes = size_t(width)*size_t(height)*bytesPerTexel;
+      const char* src = mapBinary(xml,bytes);
       
       texture = std::make_shared<Texture>(width,height,format);
-      if (width*height != fread(texture->data, bytesPerTexel, width*height, binFile)) 
-        THROW_RUNTIME_ERROR("error reading from binary file: "+binFileName.str());
+      memcpy(texture->data, src, bytes);
     }
     
     if (id != "") state.textureMap[id] = texture;
@@ -1445,19 +1473,14 @@ namespace embree
   }
 
   XMLLoader::XMLLoader(const FileName& fileName, const AffineSpace3fa& space, SharedState& state)
-    : binFile(nullptr), binFileSize(0), state(state), currentNodeID(0)
+    : binFile(nullptr), binFileOffset(0), state(state), currentNodeID(0)
   {
     path = fileName.path();
     binFileName = fileName.setExt(".bin");
-    binFile = fopen(binFileName.c_str(),"rb");
+    binFile = mapFileOpt(binFileName);
     if (!binFile) {
       binFileName = fileName.addExt(".bin");
-      binFile = fopen(binFileName.c_str(),"rb");
-    }
-    if (binFile) {
-      fseek(binFile, 0L, SEEK_END);
-      binFileSize = ftell(binFile);
-      fseek(binFile, 0L, SEEK_SET);
+      binFile = mapFileOpt(binFileName);
     }
 
     Ref<XML> xml = parseXML(fileName);
@@ -1486,7 +1509,6 @@ namespace embree
   }
 
   XMLLoader::~XMLLoader() {
-    if (binFile) fclose(binFile);
   }
 
   /*! read from disk */
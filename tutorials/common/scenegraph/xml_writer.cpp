@@ -36,6 +36,7 @@ namespace embree
     template<typename T> void store(const char* name, const std::vector<T>& vec);
     void store(const char* name, const avector<Vec3fa>& vec);
     void store4f(const char* name, const avector<Vec3fa>& vec);
+    std::streampos alignBinary();
     void store_parm(const char* name, const float& v);
     void store_parm(const char* name, const Vec3fa& v);
     void store_parm(const char* name, const std::shared_ptr<Texture> tex);
@@ -126,26 +127,36 @@ namespace embree
     tab(); xml << "<" << name << ">" << v.x << " " << v.y << " " << v.z << "</" << name << ">" << std::endl;
   }
 
+  /*! pads the .bin file such that arrays start at 16 byte aligned offsets, which lets the loader copy them from the mapped file */
+  std::streampos XMLWriter::alignBinary()
+  {
+    const char zeros[16] = { 0 };
+    std::streampos offset = bin.tellg();
+    const size_t padding = (16 - size_t(offset) % 16) % 16;
+    if (padding) bin.write(zeros,padding);
+    return offset + std::streamoff(padding);
+  }
+
   template<typename T>
   void XMLWriter::store(const char* name, const std::vector<T>& vec)
   {
-    std::streampos offset = bin.tellg();
+    std::streampos offset = alignBinary();
     tab(); xml << "<" << name << " ofs=\"" << offset << "\" size=\"" << vec.size() << "\"/>" << std::endl;
     if (vec.size()) bin.write((char*)vec.data(),vec.size()*sizeof(T));
   }
 
   void XMLWriter::store(const char* name, const avector<Vec3fa>& vec)
   {
-    std::streampos offset = bin.tellg();
-    tab(); xml << "<" << name << " ofs=\"" << offset << "\" size=\"" << vec.size() << "\"/>" << std::endl;
-    for (size_t i=0; i<vec.size(); i++) bin.write((char*)&vec[i],sizeof(Vec3f));
+    std::streampos offset = alignBinary();
+    tab(); xml << "<" << name << " ofs=\"" << offset << "\" size=\"" << vec.size() << "\" format=\"float4\"/>" << std::endl;
+    if (vec.size()) bin.write((char*)vec.data(),vec.size()*sizeof(Vec3fa));
   }
 
   void XMLWriter::store4f(const char* name, const avector<Vec3fa>& vec)
   {
-    std::streampos offset = bin.tellg();
+    std::streampos offset = alignBinary();
     tab(); xml << "<" << name << " ofs=\"" << offset << "\" size=\"" << vec.size() << "\"/>" << std::endl;
-    for (size_t i=0; i<vec.size(); i++) bin.write((char*)&vec[i],sizeof(Vec3fa));
+    if (vec.size()) bin.write((char*)vec.data(),vec.size()*sizeof(Vec3fa));
   }
 
   void XMLWriter::store_parm(const char* name, const float& v) {
@@ -163,7 +174,7 @@ namespace embree
     if (textureMap.find(tex) != textureMap.end()) {
       tab(); xml << "<texture3d name=\"" << name << "\" id=\"" << textureMap[tex] << "\"/>" << std::endl;
     } else if (embedTextures) {
-      std::streampos offset = bin.tellg();
+      std::streampos offset = alignBinary();
       bin.write((char*)tex->data,tex->width*tex->height*tex->bytesPerTexel);
       const size_t id = textureMap[tex] = currentNodeID++;
       tab(); xml << "<texture3d name=\"" << name << "\" id=\"" << id << "\" ofs=\"" << offset 
@@ -578,7 +589,7 @@ namespace embree
     }
     
     open("MultiTransform");
-    std::streampos offset = bin.tellg();
+    std::streampos offset = alignBinary();
     tab(); xml << "<AffineSpace3f ofs=\"" << offset << "\" size=\"" << nodes.size() << "\"/>" << std::endl;
     for (size_t i=0; i<nodes.size(); i++) {
       assert(nodes[i]->spaces.size() == 1);
@@ -30,6 +30,7 @@ namespace embree
     SHADER_TEXCOORDS_GRID,
     SHADER_NG,
     SHADER_CYCLES,
+    SHADER_HEATMAP,
     SHADER_GEOMID,
     SHADER_GEOMID_PRIMID,
     SHADER_AMBIENT_OCCLUSION
@@ -508,6 +508,68 @@ void renderTileCycles(int taskIndex,
   }
 }
 
+/* intensity scaling for traversal statistics visualization */
+static float heatmap_scale = 1.0f/256.0f;
+
+/* vizualizes the number of traversed nodes and intersected primitives of a pixel */
+Vec3fa renderPixelHeatMap(float x, float y, const ISPCCamera& camera, RayStats& stats)
+{
+  /* initialize ray */
+  Ray ray;
+  ray.org = Vec3fa(camera.xfm.p);
+  ray.dir = Vec3fa(normalize(x*camera.xfm.l.vx + y*camera.xfm.l.vy + camera.xfm.l.vz));
+  ray.tnear() = 0.0f;
+  ray.tfar = inf;
+  ray.geomID = RTC_INVALID_GEOMETRY_ID;
+  ray.primID = RTC_INVALID_GEOMETRY_ID;
+  ray.mask = -1;
+  ray.time() = g_debug;
+
+  /* intersect ray with scene and gather traversal statistics */
+  RTCTraversalStatistics trav_stats;
+  trav_stats.nodes = trav_stats.leaves = trav_stats.primitives = trav_stats.filters = trav_stats.instances = 0;
+  RTCIntersectContext context;
+  rtcInitIntersectContext(&context);
+  context.flags = (RTCIntersectContextFlags) (context.flags | RTC_INTERSECT_CONTEXT_FLAG_STATISTICS);
+  context.stats = &trav_stats;
+  rtcIntersect1(g_scene,&context,RTCRayHit_(ray));
+  RayStats_addRay(stats);
+
+  /* shade pixel from blue (cheap) to red (expensive) */
+  const float t = clamp((float)(trav_stats.nodes+trav_stats.primitives)*heatmap_scale,0.0f,1.0f);
+  return Vec3fa(t,0.0f,1.0f-t);
+}
+
+void renderTileHeatMap(int taskIndex,
+                       int threadIndex,
+                       int* pixels,
+                       const unsigned int width,
+                       const unsigned int height,
+                       const float time,
+                       const ISPCCamera& camera,
+                       const int numTilesX,
+                       const int numTilesY)
+{
+  const int t = taskIndex;
+  const unsigned int tileY = t / numTilesX;
+  const unsigned int tileX = t - tileY * numTilesX;
+  const unsigned int x0 = tileX * TILE_SIZE_X;
+  const unsigned int x1 = min(x0+TILE_SIZE_X,width);
+  const unsigned int y0 = tileY * TILE_SIZE_Y;
+  const unsigned int y1 = min(y0+TILE_SIZE_Y,height);
+
+  for (unsigned int y=y0; y<y1; y++) for (unsigned int x=x0; x<x1; x++)
+  {
+    Vec3fa color = renderPixelHeatMap((float)x,(float)y,camera,g_stats[threadIndex]);
+
+    /* write color to framebuffer */
+    unsigned int r = (unsigned int) (255.0f * clamp(color.x,0.0f,1.0f));
+    unsigned int g = (unsigned int) (255.0f * clamp(color.y,0.0f,1.0f));
+    unsigned int b = (unsigned int) (255.0f * clamp(color.z,0.0f,1.0f));
+    pixels[y*width+x] = (b << 16) + (g << 8) + r;
+  }
+}
+
 /* renders a single pixel with ambient occlusion */
 Vec3fa renderPixelAmbientOcclusion(float x, float y, const ISPCCamera& camera, RayStats& stats)
 {
@@ -800,6 +862,11 @@ extern "C" void device_key_pressed_default(int key)
     renderTile = renderTileAmbientOcclusion;
     g_changed = true;
   }
+  else if (key == GLFW_KEY_H) {
+    if (renderTile == renderTileHeatMap) heatmap_scale *= 2.0f;
+    renderTile = renderTileHeatMap;
+    g_changed = true;
+  }
   else if (key == GLFW_KEY_F12) {
     if (renderTile == renderTileDifferentials) {
       differentialMode = (differentialMode+1)%17;
@@ -86,6 +86,10 @@ inline Vec3fa faceforward( const Vec3fa& N, const Vec3fa& I, const Vec3fa& Ng )
 #define GLFW_KEY_F12                301
 #endif
 
+#if !defined(GLFW_KEY_H)
+#define GLFW_KEY_H                  72
+#endif
+
 /* standard shading function */
 typedef void (* renderTileFunc)(int taskIndex,
                                         int threadIndex,
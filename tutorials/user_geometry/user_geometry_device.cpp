@@ -94,9 +94,9 @@ void instanceIntersectFunc(const RTCIntersectFunctionNArguments* args)
   ray->dir = xfmVector(instance->world2local,ray_dir);
   ray->tnear() = ray_tnear;
   ray->tfar  = ray_tfar;
-  context->instID[0] = instance->userID;
+  pushInstanceId(context, instance->userID);
   rtcIntersect1(instance->object,context,RTCRayHit_(*ray));
-  context->instID[0] = -1;
+  popInstanceId(context);
   const float updated_tfar = ray->tfar;
   ray->org = ray_org;
   ray->dir = ray_dir;
@@ -123,9 +123,9 @@ void instanceOccludedFunc(const RTCOccludedFunctionNArguments* args)
   ray->dir    = xfmVector(instance->world2local,ray_dir);
   ray->tnear()  = ray_tnear;
   ray->tfar   = ray_tfar;
-  context->instID[0] = instance->userID;
+  pushInstanceId(context, instance->userID);
   rtcOccluded1(instance->object,context,RTCRay_(*ray));
-  context->instID[0] = -1;
+  popInstanceId(context);
   const float updated_tfar = ray->tfar;
   ray->org    = ray_org;
   ray->dir    = ray_dir;
@@ -173,9 +173,9 @@ void instanceIntersectFuncN(const RTCIntersectFunctionNArguments* args)
     ray.geomID = RTC_INVALID_GEOMETRY_ID;
 
     /* trace ray through object */
-    context->instID[0] = instance->userID;
+    pushInstanceId(context, instance->userID);
     rtcIntersect1(instance->object,context,RTCRayHit_(ray));
-    context->instID[0] = -1;
+    popInstanceId(context);
     if (ray.geomID == RTC_INVALID_GEOMETRY_ID) continue;
 
     /* update hit */
@@ -222,9 +222,9 @@ void instanceOccludedFuncN(const RTCOccludedFunctionNArguments* args)
     ray.geomID = RTC_INVALID_GEOMETRY_ID;
 
     /* trace ray through object */
-    context->instID[0] = instance->userID;
+    pushInstanceId(context, instance->userID);
     rtcOccluded1(instance->object,context,RTCRay_(ray));
-    context->instID[0] = -1;
+    popInstanceId(context);
     if (ray.tfar >= 0.0f) continue;
 
     /* update hit */
@@ -324,7 +324,8 @@ void sphereIntersectFunc(const RTCIntersectFunctionNArguments* args)
   RTCHit potentialHit;
   potentialHit.u = 0.0f;
   potentialHit.v = 0.0f;
-  potentialHit.instID[0] = args->context->instID[0];
+  for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    potentialHit.instID[l] = args->context->instID[l];
   potentialHit.geomID = sphere.geomID;
   potentialHit.primID = primID;
   if ((ray->tnear() < t0) & (t0 < ray->tfar))
@@ -418,7 +419,8 @@ void sphereOccludedFunc(const RTCOccludedFunctionNArguments* args)
   RTCHit potentialHit;
   potentialHit.u = 0.0f;
   potentialHit.v = 0.0f;
-  potentialHit.instID[0] = args->context->instID[0];
+  for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+    potentialHit.instID[l] = args->context->instID[l];
   potentialHit.geomID = sphere.geomID;
   potentialHit.primID = primID;
   if ((ray->tnear() < t0) & (t0 < ray->tfar))
@@ -528,7 +530,8 @@ void sphereIntersectFuncN(const RTCIntersectFunctionNArguments* args)
     RTCHit potentialhit;
     potentialhit.u = 0.0f;
     potentialhit.v = 0.0f;
-    potentialhit.instID[0] = args->context->instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      potentialhit.instID[l] = args->context->instID[l];
     potentialhit.geomID = sphere.geomID;
     potentialhit.primID = primID;
 
@@ -635,7 +638,8 @@ void sphereOccludedFuncN(const RTCOccludedFunctionNArguments* args)
 
     potentialhit.u = 0.0f;
     potentialhit.v = 0.0f;
-    potentialhit.instID[0] = args->context->instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      potentialhit.instID[l] = args->context->instID[l];
     potentialhit.geomID = sphere.geomID;
     potentialhit.primID = primID;
     if ((ray_tnear < t0) & (t0 < ray_tfar))
@@ -1016,16 +1020,16 @@ Vec3fa renderPixelStandard(float x, float y, const ISPCCamera& camera, RayStats&
     /* calculate shading normal in world space */
     Vec3fa Ns = ray.Ng;
 
-    if (ray.instID != RTC_INVALID_GEOMETRY_ID) {
-      Ns = xfmVector(g_instance[ray.instID]->normal2world,Vec3fa(Ns));
+    if (ray.instID[0] != RTC_INVALID_GEOMETRY_ID) {
+      Ns = xfmVector(g_instance[ray.instID[0]]->normal2world,Vec3fa(Ns));
     }
     Ns = face_forward(ray.dir,normalize(Ns));
 
     /* calculate diffuse color of geometries */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (ray.instID ==  0) diffuse = colors[ray.instID][ray.primID];
-    else if (ray.instID == -1) diffuse = colors[4][ray.primID];
-    else                       diffuse = colors[ray.instID][ray.geomID];
+    if      (ray.instID[0] ==  0) diffuse = colors[ray.instID[0]][ray.primID];
+    else if (ray.instID[0] == -1) diffuse = colors[4][ray.primID];
+    else                       diffuse = colors[ray.instID[0]][ray.geomID];
     color = color + diffuse*0.5;
 
     /* initialize shadow ray */
@@ -1159,9 +1163,9 @@ void renderTileStandardStream(int taskIndex,
 
     /* calculate diffuse color of geometries */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (primary.instID ==  0) diffuse = colors[primary.instID][primary.primID];
-    else if (primary.instID == -1) diffuse = colors[4][primary.primID];      
-    else                           diffuse = colors[primary.instID][primary.geomID];
+    if      (primary.instID[0] ==  0) diffuse = colors[primary.instID[0]][primary.primID];
+    else if (primary.instID[0] == -1) diffuse = colors[4][primary.primID];      
+    else                           diffuse = colors[primary.instID[0]][primary.geomID];
     color_stream[N] = color_stream[N] + diffuse*0.5;
 
     /* initialize shadow ray */
@@ -1195,16 +1199,16 @@ void renderTileStandardStream(int taskIndex,
     /* calculate shading normal in world space */
     Ray& primary = primary_stream[N];
     Vec3fa Ns = primary.Ng;
-    if (primary.instID != RTC_INVALID_GEOMETRY_ID) {
-      Ns = xfmVector(g_instance[primary.instID]->normal2world,Vec3fa(Ns));
+    if (primary.instID[0] != RTC_INVALID_GEOMETRY_ID) {
+      Ns = xfmVector(g_instance[primary.instID[0]]->normal2world,Vec3fa(Ns));
     }
     Ns = face_forward(primary.dir,normalize(Ns));
     
     /* add light contrinution */
     Vec3fa diffuse = Vec3fa(0.0f);
-    if      (primary.instID ==  0) diffuse = colors[primary.instID][primary.primID];
-    else if (primary.instID == -1) diffuse = colors[4][primary.primID];      
-    else                           diffuse = colors[primary.instID][primary.geomID];
+    if      (primary.instID[0] ==  0) diffuse = colors[primary.instID[0]][primary.primID];
+    else if (primary.instID[0] == -1) diffuse = colors[4][primary.primID];      
+    else                           diffuse = colors[primary.instID[0]][primary.geomID];
     Ray& shadow = shadow_stream[N];
     if (shadow.tfar >= 0.0f) {
       color_stream[N] = color_stream[N] + diffuse*clamp(-dot(lightDir,Ns),0.0f,1.0f);
@@ -146,7 +146,8 @@ namespace embree
     rh.hit.v = 0.0f;
     rh.hit.geomID = -1;
     rh.hit.primID = -1;
-    rh.hit.instID[0] = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
   }
 
   __forceinline RTCRayHit makeRay(const Vec3fa& org, const Vec3fa& dir) 
@@ -156,7 +157,9 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = 0.0f; rh.ray.tfar = inf;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -167,7 +170,9 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = tnear; rh.ray.tfar = tfar;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -180,7 +185,9 @@ namespace embree
     rh.ray.tfar = inf;
     rh.ray.time = 0; 
     rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -197,7 +204,9 @@ namespace embree
     rh.ray.tfar = inf;
     rh.ray.time = 0; 
     rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
   }
 
   __forceinline void fastMakeRay(RTCRayHit& ray, const Vec3fa& org, RandomSampler& sampler)
@@ -212,7 +221,9 @@ namespace embree
     rh.ray.dir_x = dir.x; rh.ray.dir_y = dir.y; rh.ray.dir_z = dir.z;
     rh.ray.tnear = tnear; rh.ray.tfar = tfar;
     rh.ray.time = 0; rh.ray.mask = -1;
-    rh.hit.geomID = rh.hit.primID = rh.hit.instID[0] = -1;
+    rh.hit.geomID = rh.hit.primID = -1;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rh.hit.instID[l] = -1;
     return rh;
   }
 
@@ -230,7 +241,8 @@ namespace embree
     if (*(int*)&ray0.ray.mask   != *(int*)&ray1.ray.mask  ) return true;
     if (*(int*)&ray0.hit.u      != *(int*)&ray1.hit.u     ) return true;
     if (*(int*)&ray0.hit.v      != *(int*)&ray1.hit.v     ) return true;
-    if (*(int*)&ray0.hit.instID[0] != *(int*)&ray1.hit.instID[0]) return true;
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      if (*(int*)&ray0.hit.instID[l] != *(int*)&ray1.hit.instID[l]) return true;
     if (*(int*)&ray0.hit.geomID != *(int*)&ray1.hit.geomID) return true;
     if (*(int*)&ray0.hit.primID != *(int*)&ray1.hit.primID) return true;
     if (*(int*)&ray0.hit.Ng_x  != *(int*)&ray1.hit.Ng_x ) return true;
@@ -270,7 +282,8 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -292,7 +305,8 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -314,7 +328,8 @@ namespace embree
     ray_o.ray.tfar[i] = ray_i.ray.tfar;
     ray_o.ray.time[i] = ray_i.ray.time;
     ray_o.ray.mask[i] = ray_i.ray.mask;
-    ray_o.hit.instID[0][i] = ray_i.hit.instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l][i] = ray_i.hit.instID[l];
     ray_o.hit.geomID[i] = ray_i.hit.geomID;
     ray_o.hit.primID[i] = ray_i.hit.primID;
     ray_o.hit.u[i] = ray_i.hit.u;
@@ -338,7 +353,8 @@ namespace embree
     RTCRayN_time(ray_o,N,i) = ray_i.ray.time;
     RTCRayN_mask(ray_o,N,i) = ray_i.ray.mask;
     RTCHitN* hit_o = RTCRayHitN_HitN(rayhit_o,N);
-    RTCHitN_instID(hit_o,N,i,0) = ray_i.hit.instID[0];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      RTCHitN_instID(hit_o,N,i,l) = ray_i.hit.instID[l];
     RTCHitN_geomID(hit_o,N,i) = ray_i.hit.geomID;
     RTCHitN_primID(hit_o,N,i) = ray_i.hit.primID;
     RTCHitN_u(hit_o,N,i) = ray_i.hit.u;
@@ -361,7 +377,8 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -385,7 +402,8 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -409,7 +427,8 @@ namespace embree
     ray_o.ray.tfar = ray_i.ray.tfar[i];
     ray_o.ray.time = ray_i.ray.time[i];
     ray_o.ray.mask = ray_i.ray.mask[i];
-    ray_o.hit.instID[0] = ray_i.hit.instID[0][i];
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l] = ray_i.hit.instID[l][i];
     ray_o.hit.geomID = ray_i.hit.geomID[i];
     ray_o.hit.primID = ray_i.hit.primID[i];
     ray_o.hit.u = ray_i.hit.u[i];
@@ -435,7 +454,8 @@ namespace embree
     ray_o.ray.tfar  = RTCRayN_tfar(ray_i,N,i);
     ray_o.ray.time = RTCRayN_time(ray_i,N,i);
     ray_o.ray.mask = RTCRayN_mask(ray_i,N,i);
-    ray_o.hit.instID[0] = RTCHitN_instID(hit_i,N,i,0);
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      ray_o.hit.instID[l] = RTCHitN_instID(hit_i,N,i,l);
     ray_o.hit.geomID = RTCHitN_geomID(hit_i,N,i);
     ray_o.hit.primID = RTCHitN_primID(hit_i,N,i);
     ray_o.hit.u = RTCHitN_u(hit_i,N,i);
@@ -578,7 +598,8 @@ namespace embree
     else ret += "Static";
     if (scene_flags & RTC_SCENE_FLAG_COMPACT) ret += "Compact";
     if (scene_flags & RTC_SCENE_FLAG_ROBUST ) ret += "Robust";
-    if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST)) ret += "Fast"; 
+    if (scene_flags & RTC_SCENE_FLAG_QUANTIZED) ret += "Quantized";
+    if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST) && !(scene_flags & RTC_SCENE_FLAG_QUANTIZED)) ret += "Fast"; 
     return ret;
   }
   
@@ -691,7 +712,8 @@ namespace embree
     rayp.ray.mask = &RTCRayN_mask(ray, N, 0);
     rayp.ray.id = &RTCRayN_id(ray, N, 0);
     rayp.ray.flags = &RTCRayN_flags(ray, N, 0);
-    rayp.hit.instID[0] = &RTCHitN_instID(hit, N, 0, 0);
+    for (unsigned l = 0; l < RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      rayp.hit.instID[l] = &RTCHitN_instID(hit, N, 0, l);
     rayp.hit.geomID = &RTCHitN_geomID(hit, N, 0);
     rayp.hit.primID = &RTCHitN_primID(hit, N, 0);
     rayp.hit.u = &RTCHitN_u(hit, N, 0);
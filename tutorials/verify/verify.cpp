@@ -22,6 +22,7 @@
 #include "../../common/algorithms/parallel_for.h"
 #include <regex>
 #include <stack>
+#include <thread>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -346,6 +347,33 @@ namespace embree
       return std::make_pair(geomID,Ref<SceneGraph::Node>(nullptr));
     }
 
+    /*! adds a triangle sphere, a quad sphere, and a plane of flat curves */
+    void addMixedGeometries (RTCBuildQuality quality, int seed)
+    {
+      const Vec3fa center = zero;
+      const float radius = 1.0f;
+      const Vec3fa dx(1,0,0);
+      const Vec3fa dy(0,1,0);
+      addGeometry(quality,SceneGraph::createTriangleSphere(center,radius,50));
+      addGeometry(quality,SceneGraph::createQuadSphere(center+Vec3fa(0.5f),radius,50));
+      addGeometry(quality,SceneGraph::createHairyPlane(seed,center,dx,dy,0.1f,0.01f,100,SceneGraph::FLAT_CURVE));
+    }
+
+    /*! adds unconnected triangles, the centerAndSize function returns the center and size of each triangle */
+    template<typename CenterAndSize>
+    std::pair<unsigned,Ref<SceneGraph::Node>> addTriangleSoup (RandomSampler& sampler, RTCBuildQuality quality, size_t numTriangles, const CenterAndSize& centerAndSize)
+    {
+      Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(nullptr,1);
+      for (size_t i=0; i<numTriangles; i++)
+      {
+        const std::pair<Vec3fa,float> cs = centerAndSize(i);
+        for (size_t j=0; j<3; j++)
+          mesh->positions[0].push_back(cs.first + cs.second*RandomSampler_get3D(sampler));
+        mesh->triangles.push_back(SceneGraph::TriangleMeshNode::Triangle(unsigned(3*i+0),unsigned(3*i+1),unsigned(3*i+2)));
+      }
+      return addGeometry2(quality,mesh.dynamicCast<SceneGraph::Node>());
+    }
+
     void resizeRandomly (std::pair<unsigned,Ref<SceneGraph::Node>> geom, RandomSampler& sampler)
     {
       if (Ref<SceneGraph::TriangleMeshNode> mesh = geom.second.dynamicCast<SceneGraph::TriangleMeshNode>())
@@ -372,6 +400,25 @@ namespace embree
     std::vector<Ref<SceneGraph::Node>> nodes;
   };
 
+  /*! checks that two scenes report the same hits for the rays returned by makeRayi */
+  template<typename MakeRay>
+  bool sameHits (RTCScene scene0, RTCScene scene1, size_t numRays, const MakeRay& makeRayi, float relError = 0.0f)
+  {
+    RTCIntersectContext context;
+    rtcInitIntersectContext(&context);
+    for (size_t i=0; i<numRays; i++)
+    {
+      RTCRayHit ray0 = makeRayi(i);
+      RTCRayHit ray1 = ray0;
+      rtcIntersect1(scene0,&context,&ray0);
+      rtcIntersect1(scene1,&context,&ray1);
+      if (ray0.hit.geomID != ray1.hit.geomID) return false;
+      if (ray0.hit.primID != ray1.hit.primID) return false;
+      if (ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(ray0.ray.tfar-ray1.ray.tfar) > relError*abs(ray0.ray.tfar)) return false;
+    }
+    return true;
+  }
+
   VerifyApplication::TestReturnValue VerifyApplication::Test::execute(VerifyApplication* state, bool silent)
   {
     if (!isEnabled())
@@ -1140,6 +1187,503 @@ namespace embree
     }
   };
 
+  struct SaveLoadSceneTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    SaveLoadSceneTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* dynamic scenes use two level hierarchies which cannot get saved */
+      if (sflags.sflags & RTC_SCENE_FLAG_DYNAMIC)
+        return VerifyApplication::SKIPPED;
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const int seed = RandomSampler_getInt(sampler);
+      const std::string fileName = "verify_save_load_" + stringOfISA(isa) + "_" + name + ".bvh";
+
+      VerifyScene scene0(device,sflags);
+      scene0.addMixedGeometries(quality,seed);
+      rtcCommitScene (scene0);
+      rtcSaveScene (scene0,fileName.c_str());
+      AssertNoError(device);
+
+      VerifyScene scene1(device,sflags);
+      scene1.addMixedGeometries(quality,seed);
+      rtcLoadScene (scene1,fileName.c_str());
+      std::remove(fileName.c_str());
+      AssertNoError(device);
+
+      const bool passed = sameHits(scene0,scene1,1024,[&] (size_t i) {
+          return makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        });
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct CommitSceneAsyncTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    CommitSceneAsyncTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    struct CommitState
+    {
+      CommitState () : calls(0), error(RTC_ERROR_NONE) {}
+      std::atomic<int> calls;
+      RTCError error;
+    };
+
+    static void commitDone(void* ptr, RTCError error)
+    {
+      CommitState* state = (CommitState*) ptr;
+      state->error = error;
+      state->calls++;
+    }
+
+    struct ReleaseState
+    {
+      ReleaseState (RTCScene scene) : scene(scene), released(false) {}
+      RTCScene scene;
+      std::atomic<bool> released;
+    };
+
+    /* releases the last reference to the scene from inside the callback */
+    static void commitDoneRelease(void* ptr, RTCError error)
+    {
+      ReleaseState* state = (ReleaseState*) ptr;
+      rtcReleaseScene(state->scene);
+      state->released = true;
+    }
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const int seed = RandomSampler_getInt(sampler);
+      VerifyScene scene0(device,sflags);
+      scene0.addMixedGeometries(quality,seed);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      /* commit twice to test that a pending commit gets finished first */
+      CommitState commitState;
+      VerifyScene scene1(device,sflags);
+      scene1.addMixedGeometries(quality,seed);
+      rtcCommitSceneAsync (scene1,commitDone,&commitState);
+      rtcCommitSceneAsync (scene1,commitDone,&commitState);
+      rtcJoinCommitScene (scene1);
+      AssertNoError(device);
+      if (commitState.calls != 2 || commitState.error != RTC_ERROR_NONE)
+        return VerifyApplication::FAILED;
+
+      /* a synchronous commit has to wait for the pending asynchronous commit */
+      rtcCommitSceneAsync (scene1,commitDone,&commitState);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+      if (commitState.calls != 3 || commitState.error != RTC_ERROR_NONE)
+        return VerifyApplication::FAILED;
+
+      const bool passed = sameHits(scene0,scene1,1024,[&] (size_t i) {
+          return makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        });
+      AssertNoError(device);
+
+      /* releasing the scene inside the callback must not deadlock */
+      ReleaseState releaseState(rtcNewScene(device));
+      rtcCommitSceneAsync (releaseState.scene,commitDoneRelease,&releaseState);
+      while (!releaseState.released) std::this_thread::yield();
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct QuantizedSceneTest : public VerifyApplication::IntersectTest
+  {
+    QuantizedSceneTest (std::string name, int isa, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the same geometries once with regular and once with quantized BVH nodes */
+      const int seed = RandomSampler_getInt(sampler);
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      scene0.addMixedGeometries(RTC_BUILD_QUALITY_MEDIUM,seed);
+      rtcCommitScene (scene0);
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_QUANTIZED,RTC_BUILD_QUALITY_MEDIUM));
+      scene1.addMixedGeometries(RTC_BUILD_QUALITY_MEDIUM,seed);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      /* both scenes have to report the same hits, the leaf intersectors may differ slightly in the hit distance */
+      const size_t numRays = 512;
+      __aligned(16) RTCRayHit rays0[numRays], rays1[numRays];
+      for (size_t i=0; i<numRays; i++)
+        rays0[i] = rays1[i] = makeRay(4.0f*random_Vec3fa()-Vec3fa(2.0f),2.0f*random_Vec3fa()-Vec3fa(1.0f));
+      IntersectWithMode(imode,ivariant,scene0,rays0,numRays);
+      IntersectWithMode(imode,ivariant,scene1,rays1,numRays);
+      AssertNoError(device);
+
+      for (size_t i=0; i<numRays; i++)
+      {
+        if (rays0[i].hit.geomID != rays1[i].hit.geomID) return VerifyApplication::FAILED;
+        if (rays0[i].hit.primID != rays1[i].hit.primID) return VerifyApplication::FAILED;
+        if (rays0[i].hit.geomID != RTC_INVALID_GEOMETRY_ID && abs(rays0[i].ray.tfar-rays1[i].ray.tfar) > 1E-4f*abs(rays0[i].ray.tfar))
+          return VerifyApplication::FAILED;
+        if ((rays0[i].ray.tfar == float(neg_inf)) != (rays1[i].ray.tfar == float(neg_inf)))
+          return VerifyApplication::FAILED;
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct PointQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    PointQueryTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    static float distanceToSegment(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b)
+    {
+      const float t = clamp(dot(p-a,b-a)/dot(b-a,b-a),0.0f,1.0f);
+      return length(p-(a+t*(b-a)));
+    }
+
+    static float distanceToTriangle(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+    {
+      const Vec3fa N = cross(b-a,c-a);
+      const Vec3fa q = p - dot(p-a,N)/dot(N,N)*N;
+      if (dot(cross(b-a,q-a),N) >= 0.0f && dot(cross(c-b,q-b),N) >= 0.0f && dot(cross(a-c,q-c),N) >= 0.0f)
+        return length(p-q);
+      return min(distanceToSegment(p,a,b),distanceToSegment(p,b,c),distanceToSegment(p,c,a));
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* collect all triangles of the scene for a brute force reference */
+      avector<Vec3fa> triangles;
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<8; i++)
+      {
+        const Vec3fa center = 8.0f*random_Vec3fa()-Vec3fa(4.0f);
+        if (i%2 == 0) {
+          Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(center,0.5f,8).dynamicCast<SceneGraph::TriangleMeshNode>();
+          scene.addGeometry(quality,mesh.dynamicCast<SceneGraph::Node>());
+          for (auto& tri : mesh->triangles) {
+            triangles.push_back(mesh->positions[0][tri.v0]);
+            triangles.push_back(mesh->positions[0][tri.v1]);
+            triangles.push_back(mesh->positions[0][tri.v2]);
+          }
+        } else {
+          Ref<SceneGraph::QuadMeshNode> mesh = SceneGraph::createQuadSphere(center,0.5f,8).dynamicCast<SceneGraph::QuadMeshNode>();
+          scene.addGeometry(quality,mesh.dynamicCast<SceneGraph::Node>());
+          for (auto& quad : mesh->quads) {
+            const unsigned int v[6] = { quad.v0, quad.v1, quad.v3, quad.v2, quad.v3, quad.v1 };
+            for (size_t j=0; j<6; j++) triangles.push_back(mesh->positions[0][v[j]]);
+          }
+        }
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<64; i++)
+      {
+        const Vec3fa p = 12.0f*random_Vec3fa()-Vec3fa(6.0f);
+        float dist = inf;
+        for (size_t j=0; j<triangles.size(); j+=3)
+          dist = min(dist,distanceToTriangle(p,triangles[j+0],triangles[j+1],triangles[j+2]));
+
+        RTCPointQuery query;
+        query.x = p.x; query.y = p.y; query.z = p.z;
+        query.time = 0.0f;
+        query.radius = inf;
+        RTCClosestPoint result;
+        if (!rtcClosestPoint(scene,&query,&result)) return VerifyApplication::FAILED;
+        if (result.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+        if (abs(query.radius-dist) > 1E-4f*(1.0f+dist)) return VerifyApplication::FAILED;
+        const Vec3fa q(result.p_x,result.p_y,result.p_z);
+        if (abs(length(q-p)-dist) > 1E-4f*(1.0f+dist)) return VerifyApplication::FAILED;
+
+        /* nothing must be found when the query radius is smaller than the closest distance */
+        query.radius = 0.99f*dist;
+        if (rtcClosestPoint(scene,&query,&result)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CollideTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    CollideTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    struct Collisions
+    {
+      Collisions () : duplicates(0) {}
+      MutexSys mutex;
+      std::set<std::pair<size_t,size_t>> pairs;
+      size_t duplicates;
+    };
+
+    static void collideFunc(void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      Collisions* data = (Collisions*) userPtr;
+      Lock<MutexSys> lock(data->mutex);
+      for (size_t i=0; i<num_collisions; i++) {
+        const RTCCollision& c = collisions[i];
+        if (!data->pairs.insert(std::make_pair(size_t(c.geomID0) << 32 | c.primID0,size_t(c.geomID1) << 32 | c.primID1)).second)
+          data->duplicates++;
+      }
+    }
+
+    void addSpheres(VerifyScene& scene, RTCBuildQuality quality, size_t num, avector<BBox3fa>& bounds, std::vector<size_t>& ids)
+    {
+      for (size_t i=0; i<num; i++)
+      {
+        const Vec3fa center = 4.0f*random_Vec3fa()-Vec3fa(2.0f);
+        Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(center,0.5f,6).dynamicCast<SceneGraph::TriangleMeshNode>();
+        const unsigned geomID = scene.addGeometry(quality,mesh.dynamicCast<SceneGraph::Node>());
+        for (size_t j=0; j<mesh->triangles.size(); j++) {
+          const SceneGraph::TriangleMeshNode::Triangle& tri = mesh->triangles[j];
+          BBox3fa b = empty;
+          b.extend(mesh->positions[0][tri.v0]);
+          b.extend(mesh->positions[0][tri.v1]);
+          b.extend(mesh->positions[0][tri.v2]);
+          bounds.push_back(b);
+          ids.push_back(size_t(geomID) << 32 | j);
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      avector<BBox3fa> bounds0, bounds1;
+      std::vector<size_t> ids0, ids1;
+      VerifyScene scene0(device,sflags), scene1(device,sflags);
+      addSpheres(scene0,quality,4,bounds0,ids0);
+      addSpheres(scene1,quality,4,bounds1,ids1);
+      rtcCommitScene (scene0);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      /* collisions between two scenes have to match a brute force test of all pairs */
+      Collisions collisions;
+      rtcCollide(scene0,scene1,collideFunc,&collisions);
+      AssertNoError(device);
+      if (collisions.duplicates) return VerifyApplication::FAILED;
+      size_t expected = 0;
+      for (size_t i=0; i<bounds0.size(); i++)
+        for (size_t j=0; j<bounds1.size(); j++)
+          if (!disjoint(bounds0[i],bounds1[j])) {
+            expected++;
+            if (!collisions.pairs.count(std::make_pair(ids0[i],ids1[j])))
+              return VerifyApplication::FAILED;
+          }
+      if (collisions.pairs.size() != expected) return VerifyApplication::FAILED;
+
+      /* self collisions are reported once per pair */
+      Collisions selfCollisions;
+      rtcCollide(scene0,scene0,collideFunc,&selfCollisions);
+      AssertNoError(device);
+      if (selfCollisions.duplicates) return VerifyApplication::FAILED;
+      expected = 0;
+      for (size_t i=0; i<bounds0.size(); i++)
+        for (size_t j=i+1; j<bounds0.size(); j++)
+          if (!disjoint(bounds0[i],bounds0[j])) expected++;
+      if (selfCollisions.pairs.size() != expected) return VerifyApplication::FAILED;
+
+      /* scenes with curves are rejected */
+      VerifyScene scene2(device,sflags);
+      scene2.addHair(sampler,quality,zero,1.0f,1.0f,10);
+      rtcCommitScene (scene2);
+      AssertNoError(device);
+      rtcCollide(scene0,scene2,collideFunc,&collisions);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CompressedVerticesTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    CompressedVerticesTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    /* converts floats that are exactly representable in half precision */
+    static unsigned short floatToHalf(float f)
+    {
+      if (f == 0.0f) return 0;
+      const unsigned int i = cast_f2i(f);
+      return (unsigned short) (((i >> 16) & 0x8000) | ((((i >> 23) & 0xff) - 112) << 10) | ((i >> 13) & 0x3ff));
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* heightfield with integer coordinates that all vertex formats store exactly */
+      const unsigned int W = 16;
+      const unsigned int numVertices = (W+1)*(W+1);
+      const float scale[3] = { 0.25f, 0.125f, 0.25f };
+      const float offset[3] = { -2.0f, 0.0f, -2.0f };
+
+      const RTCGeometryType gtypes[2] = { RTC_GEOMETRY_TYPE_TRIANGLE, RTC_GEOMETRY_TYPE_QUAD };
+      const RTCFormat formats[2] = { RTC_FORMAT_HALF3, RTC_FORMAT_USHORT3 };
+      const size_t strides[2] = { 4, 6 }; // in shorts, 8 bytes is the smallest legal stride
+      for (auto gtype : gtypes)
+      {
+        for (auto format : formats)
+        {
+          /* strides that are no multiple of 4 bytes or smaller than a vertex are rejected */
+          unsigned short dummy[16] = { 0 };
+          RTCGeometry geom = rtcNewGeometry(device, gtype);
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,format,dummy,0,6,2);
+          AssertError(device,RTC_ERROR_INVALID_OPERATION);
+          rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,format,dummy,0,4,2);
+          AssertError(device,RTC_ERROR_INVALID_OPERATION);
+          rtcReleaseGeometry(geom);
+
+          for (unsigned int numTimeSteps=1; numTimeSteps<=2; numTimeSteps++)
+          {
+            for (size_t cstride : strides)
+            {
+              std::vector<unsigned int> indices;
+              for (unsigned int z=0; z<W; z++) {
+                for (unsigned int x=0; x<W; x++) {
+                  const unsigned int v00 = z*(W+1)+x, v01 = v00+1, v10 = v00+W+1, v11 = v10+1;
+                  if (gtype == RTC_GEOMETRY_TYPE_QUAD) {
+                    indices.push_back(v00); indices.push_back(v01); indices.push_back(v11); indices.push_back(v10);
+                  } else {
+                    indices.push_back(v00); indices.push_back(v01); indices.push_back(v11);
+                    indices.push_back(v00); indices.push_back(v11); indices.push_back(v10);
+                  }
+                }
+              }
+
+              std::vector<float> fvertices(4*numTimeSteps*numVertices);
+              std::vector<unsigned short> cvertices(cstride*numTimeSteps*numVertices);
+              for (unsigned int t=0; t<numTimeSteps; t++) {
+                for (unsigned int z=0; z<=W; z++) {
+                  for (unsigned int x=0; x<=W; x++) {
+                    const size_t id = t*numVertices+z*(W+1)+x;
+                    const float c[3] = { float(x), float((x*7+z*5)%9+t), float(z) };
+                    for (size_t k=0; k<3; k++) {
+                      fvertices[4*id+k] = offset[k]+scale[k]*c[k];
+                      cvertices[cstride*id+k] = format == RTC_FORMAT_HALF3 ? floatToHalf(c[k]) : (unsigned short) c[k];
+                    }
+                  }
+                }
+              }
+
+              const unsigned int numPrimitives = (unsigned int) (gtype == RTC_GEOMETRY_TYPE_QUAD ? indices.size()/4 : indices.size()/3);
+              const RTCFormat indexFormat = gtype == RTC_GEOMETRY_TYPE_QUAD ? RTC_FORMAT_UINT4 : RTC_FORMAT_UINT3;
+              const size_t indexStride = gtype == RTC_GEOMETRY_TYPE_QUAD ? 4*sizeof(unsigned int) : 3*sizeof(unsigned int);
+
+              RTCGeometry geom0 = rtcNewGeometry(device, gtype);
+              rtcSetGeometryTimeStepCount(geom0,numTimeSteps);
+              rtcSetGeometryBuildQuality(geom0,quality);
+              rtcSetSharedGeometryBuffer(geom0,RTC_BUFFER_TYPE_INDEX,0,indexFormat,indices.data(),0,indexStride,numPrimitives);
+              for (unsigned int t=0; t<numTimeSteps; t++)
+                rtcSetSharedGeometryBuffer(geom0,RTC_BUFFER_TYPE_VERTEX,t,RTC_FORMAT_FLOAT3,&fvertices[4*t*numVertices],0,4*sizeof(float),numVertices);
+              rtcCommitGeometry(geom0);
+              AssertNoError(device);
+
+              RTCGeometry geom1 = rtcNewGeometry(device, gtype);
+              rtcSetGeometryTimeStepCount(geom1,numTimeSteps);
+              rtcSetGeometryBuildQuality(geom1,quality);
+              rtcSetSharedGeometryBuffer(geom1,RTC_BUFFER_TYPE_INDEX,0,indexFormat,indices.data(),0,indexStride,numPrimitives);
+              for (unsigned int t=0; t<numTimeSteps; t++)
+                rtcSetSharedGeometryBuffer(geom1,RTC_BUFFER_TYPE_VERTEX,t,format,&cvertices[cstride*t*numVertices],0,cstride*sizeof(unsigned short),numVertices);
+              rtcSetGeometryVertexDequantization(geom1,scale,offset);
+              rtcCommitGeometry(geom1);
+              AssertNoError(device);
+
+              VerifyScene scene0(device,sflags);
+              rtcAttachGeometry(scene0,geom0);
+              rtcCommitScene(scene0);
+              VerifyScene scene1(device,sflags);
+              rtcAttachGeometry(scene1,geom1);
+              rtcCommitScene(scene1);
+              AssertNoError(device);
+
+              RTCIntersectContext context;
+              rtcInitIntersectContext(&context);
+              bool passed = true;
+              for (size_t i=0; i<256 && passed; i++)
+              {
+                const Vec3fa org(4.0f*random_float()-2.0f,4.0f,4.0f*random_float()-2.0f);
+                const Vec3fa dir(0.2f*random_float()-0.1f,-1.0f,0.2f*random_float()-0.1f);
+                const float time = random_float();
+                RTCRayHit ray0 = makeRay(org,dir); ray0.ray.time = time;
+                RTCRayHit ray1 = makeRay(org,dir); ray1.ray.time = time;
+                rtcIntersect1(scene0,&context,&ray0);
+                rtcIntersect1(scene1,&context,&ray1);
+                passed &= ray0.hit.geomID == ray1.hit.geomID;
+                passed &= ray0.hit.primID == ray1.hit.primID;
+                if (!passed || ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+                passed &= abs(ray0.ray.tfar-ray1.ray.tfar) < 1E-4f;
+                passed &= abs(ray0.hit.u-ray1.hit.u) < 1E-4f;
+                passed &= abs(ray0.hit.v-ray1.hit.v) < 1E-4f;
+
+                /* interpolation has to decode the compressed vertices too */
+                float P0[3], P1[3];
+                rtcInterpolate0(geom0,ray0.hit.primID,ray0.hit.u,ray0.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P0,3);
+                rtcInterpolate0(geom1,ray0.hit.primID,ray0.hit.u,ray0.hit.v,RTC_BUFFER_TYPE_VERTEX,0,P1,3);
+                for (size_t k=0; k<3; k++)
+                  passed &= abs(P0[k]-P1[k]) < 1E-4f;
+              }
+              AssertNoError(device);
+
+              rtcReleaseGeometry(geom0);
+              rtcReleaseGeometry(geom1);
+              if (!passed) return VerifyApplication::FAILED;
+            }
+          }
+        }
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1620,25 +2164,779 @@ namespace embree
       }
       AssertNoError(device);
 
-      return VerifyApplication::PASSED;
+      return VerifyApplication::PASSED;
+    }
+  };
+  
+  struct UpdateTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    UpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    static void move_mesh(RTCGeometry mesh, size_t numVertices, Vec3fa& pos) 
+    {
+      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(mesh,RTC_BUFFER_TYPE_VERTEX,0);
+      for (size_t i=0; i<numVertices; i++)
+        vertices[i] += Vec3fa(pos);
+      rtcUpdateGeometryBuffer(mesh,RTC_BUFFER_TYPE_VERTEX,0);
+      rtcCommitGeometry(mesh);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+      
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+      size_t numPhi = 10;
+      size_t numVertices = 2*numPhi*(numPhi+1);
+      Vec3fa pos0 = Vec3fa(-10,0,-10);
+      Vec3fa pos1 = Vec3fa(-10,0,+10);
+      Vec3fa pos2 = Vec3fa(+10,0,-10);
+      Vec3fa pos3 = Vec3fa(+10,0,+10);
+      unsigned geom0 = scene.addSphere      (sampler,quality,pos0,1.0f,numPhi).first;
+      unsigned geom1 = scene.addQuadSphere  (sampler,quality,pos1,1.0f,numPhi).first;
+      unsigned geom2 = scene.addSubdivSphere(sampler,quality,pos2,1.0f,numPhi,4).first;
+      unsigned geom3 = scene.addSphereHair  (sampler,quality,pos3,1.0f).first;
+      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
+      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
+      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
+      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+      AssertNoError(device);
+      
+      for (size_t i=0; i<16; i++) 
+      {
+        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
+        Vec3fa ds(2,0.1f,2,0.0f);
+        if (move0) { move_mesh(hgeom0,numVertices,ds); pos0 += ds; }
+        if (move1) { move_mesh(hgeom1,numVertices,ds); pos1 += ds; }
+        if (move2) { move_mesh(hgeom2,numVertices,ds); pos2 += ds; }
+        if (move3) { move_mesh(hgeom3,4,ds); pos3 += ds; }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        RTCRayHit ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
+        RTCRayHit ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
+        RTCRayHit ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
+        RTCRayHit ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
+        RTCRayHit testRays[4] = { ray0, ray1, ray2, ray3 };
+
+        const unsigned int maxRays = 100;
+        RTCRayHit rays[maxRays];
+        for (unsigned int numRays=1; numRays<maxRays; numRays++) {
+          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
+          IntersectWithMode(imode,ivariant,scene,rays,numRays);
+          for (size_t i=0; i<numRays; i++)
+            if (ivariant & VARIANT_INTERSECT) {
+              if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID)
+                return VerifyApplication::FAILED;
+            }
+            else {
+              if (rays[i].ray.tfar != float(neg_inf))
+                return VerifyApplication::FAILED;
+            }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct IncrementalUpdateTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    IncrementalUpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",toplevel_update_ratio=0.5,toplevel_update_max_sah=4";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,sflags);
+      AssertNoError(device);
+
+      const size_t numSpheres = 64;
+      const size_t numPhi = 10;
+      const size_t numVertices = 2*numPhi*(numPhi+1);
+      std::vector<Vec3fa> pos(numSpheres);
+      std::vector<RTCGeometry> hgeom(numSpheres);
+      std::vector<bool> enabled(numSpheres,true);
+      for (size_t k=0; k<numSpheres; k++) {
+        pos[k] = Vec3fa(4.0f*float(k%8),0.0f,4.0f*float(k/8));
+        hgeom[k] = rtcGetGeometry(scene,scene.addSphere(sampler,quality,pos[k],1.0f,numPhi).first);
+      }
+      AssertNoError(device);
+
+      for (size_t i=0; i<16; i++)
+      {
+        /* move some spheres, and alternately disable a sphere and enable it again */
+        for (size_t k=0; k<numSpheres; k++) {
+          if ((7*k+i)%5) continue;
+          Vec3fa ds((i%2) ? 0.2f : -0.2f,0.0f,0.1f,0.0f);
+          UpdateTest::move_mesh(hgeom[k],numVertices,ds); pos[k] += ds;
+        }
+        const size_t toggled = (i%2) ? (3*i)%numSpheres : (3*(i-1))%numSpheres;
+        enabled[toggled] = (i%2) == 0;
+        if (enabled[toggled]) rtcEnableGeometry (hgeom[toggled]);
+        else                  rtcDisableGeometry(hgeom[toggled]);
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t k=0; k<numSpheres; k++) 
+        {
+          RTCRayHit ray = makeRay(pos[k]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != (enabled[k] ? (unsigned int)k : RTC_INVALID_GEOMETRY_ID))
+            return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct MortonCode64Test : public VerifyApplication::Test
+  {
+    MortonCode64Test (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* a threshold of 0 lets the morton builder use 64 bit morton codes for all meshes */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",morton_code64_threshold=0";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* small triangles spread over a large region and a dense cluster at the origin that falls into few cells of the morton lattice */
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      Ref<SceneGraph::Node> mesh = scene0.addTriangleSoup(sampler,RTC_BUILD_QUALITY_MEDIUM,20000,[&] (size_t i) {
+          const bool cluster = i%2 == 0;
+          return std::make_pair((cluster ? 0.01f : 1000.0f)*(2.0f*random_Vec3fa()-Vec3fa(1.0f)),cluster ? 0.0005f : 1.0f);
+        }).second;
+      rtcCommitScene (scene0);
+
+      /* the morton builder is used for low quality geometries of dynamic scenes */
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW));
+      scene1.addGeometry2(RTC_BUILD_QUALITY_LOW,mesh);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      /* both BVHs have to report the same hits */
+      const bool passed = sameHits(scene0,scene1,1024,[&] (size_t i) {
+          const bool cluster = i%2 == 0;
+          const Vec3fa org = (cluster ? 0.02f : 1000.0f)*(2.0f*random_Vec3fa()-Vec3fa(1.0f)) - Vec3fa(0.0f,0.0f,cluster ? 1.0f : 0.0f);
+          const Vec3fa dir = cluster ? Vec3fa(0.0f,0.0f,1.0f) : 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          return makeRay(org,dir);
+        },1E-5f);
+      AssertNoError(device);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+
+  struct SceneRefitTest : public VerifyApplication::Test
+  {
+    GeometryType gtype;
+
+    SceneRefitTest (std::string name, int isa, GeometryType gtype)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), gtype(gtype) {}
+
+    template<typename Mesh>
+    static void move_mesh(RTCGeometry geom, Mesh* mesh, const Vec3fa& ds)
+    {
+      for (unsigned int t=0; t<mesh->numTimeSteps(); t++) {
+        for (auto& p : mesh->positions[t]) p += ds;
+        rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t);
+      }
+      rtcCommitGeometry(geom);
+    }
+
+    static void move_node(RTCGeometry geom, const Ref<SceneGraph::Node>& node, const Vec3fa& ds)
+    {
+      if      (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>()) move_mesh(geom,mesh.ptr,ds);
+      else if (Ref<SceneGraph::QuadMeshNode>     mesh = node.dynamicCast<SceneGraph::QuadMeshNode>    ()) move_mesh(geom,mesh.ptr,ds);
+      else if (Ref<SceneGraph::GridMeshNode>     mesh = node.dynamicCast<SceneGraph::GridMeshNode>    ()) move_mesh(geom,mesh.ptr,ds);
+      else if (Ref<SceneGraph::HairSetNode>      mesh = node.dynamicCast<SceneGraph::HairSetNode>     ()) move_mesh(geom,mesh.ptr,ds);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_MEDIUM));
+      AssertNoError(device);
+
+      /* motion blurred geometries keep their position at time 0 */
+      avector<Vec3fa> motion_vector;
+      motion_vector.push_back(Vec3fa(zero));
+      motion_vector.push_back(Vec3fa(0.0f,0.0f,0.5f));
+
+      const size_t numObjects = 16;
+      std::vector<Vec3fa> pos(numObjects);
+      std::vector<std::pair<unsigned,Ref<SceneGraph::Node>>> geom(numObjects);
+      for (size_t k=0; k<numObjects; k++)
+      {
+        pos[k] = Vec3fa(8.0f*float(k%4),0.0f,8.0f*float(k/4));
+        switch (gtype) {
+        case TRIANGLE_MESH_MB: geom[k] = scene.addSphere    (sampler,RTC_BUILD_QUALITY_REFIT,pos[k],1.0f,10,-1,motion_vector); break;
+        case QUAD_MESH_MB    : geom[k] = scene.addQuadSphere(sampler,RTC_BUILD_QUALITY_REFIT,pos[k],1.0f,10,-1,motion_vector); break;
+        case GRID_MESH       : geom[k] = scene.addGridSphere(sampler,RTC_BUILD_QUALITY_REFIT,pos[k],1.0f,4); break;
+        case HAIR_GEOMETRY   : geom[k] = scene.addSphereHair(sampler,RTC_BUILD_QUALITY_REFIT,pos[k],1.0f); break;
+        default              : return VerifyApplication::SKIPPED;
+        }
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      for (size_t i=0; i<16; i++)
+      {
+        /* move some objects further than their extent, such that a stale BVH misses them */
+        for (size_t k=0; k<numObjects; k++) {
+          if ((7*k+i)%3) continue;
+          Vec3fa ds((i%2) ? 1.5f : -1.5f,0.0f,0.0f,0.0f);
+          move_node(rtcGetGeometry(scene,geom[k].first),geom[k].second,ds); pos[k] += ds;
+        }
+        rtcCommitScene (scene);
+        AssertNoError(device);
+
+        for (size_t k=0; k<numObjects; k++)
+        {
+          RTCRayHit ray = makeRay(pos[k]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != geom[k].first)
+            return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::Test
+  {
+    TraversalStatisticsTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static void acceptAllFilter(const RTCFilterFunctionNArguments* args) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* a sphere with intersection filter function, instantiated once in the top level scene */
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = scene0.addSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,50).first;
+      rtcSetGeometryIntersectFilterFunction(rtcGetGeometry(scene0,geomID),acceptAllFilter);
+      rtcCommitGeometry(rtcGetGeometry(scene0,geomID));
+      rtcCommitScene (scene0);
+
+      VerifyScene scene1(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(inst,scene0);
+      const AffineSpace3fa xfm = one;
+      rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+      rtcCommitGeometry(inst);
+      rtcAttachGeometry(scene1,inst);
+      rtcReleaseGeometry(inst);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      /* no statistics are gathered without the statistics flag */
+      RTCTraversalStatistics stats;
+      memset(&stats,0,sizeof(stats));
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.stats = &stats;
+      RTCRayHit ray0 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1));
+      rtcIntersect1(scene1,&context,&ray0);
+      if (ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      if (stats.nodes || stats.leaves || stats.primitives || stats.filters || stats.instances)
+        return VerifyApplication::FAILED;
+
+      /* a hitting ray enters the instance, traverses both BVHs, and invokes the filter function */
+      context.flags = (RTCIntersectContextFlags) (context.flags | RTC_INTERSECT_CONTEXT_FLAG_STATISTICS);
+      RTCRayHit ray1 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,1));
+      rtcIntersect1(scene1,&context,&ray1);
+      if (ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID) return VerifyApplication::FAILED;
+      if (stats.instances != 1 || stats.nodes < 1 || stats.leaves < 2 || stats.primitives < 2 || stats.filters < 1)
+        return VerifyApplication::FAILED;
+
+      /* the counters accumulate over queries, a missing ray does not invoke the filter function */
+      const RTCTraversalStatistics stats1 = stats;
+      RTCRay ray2 = makeRay(Vec3fa(0,0,-10),Vec3fa(0,0,-1)).ray;
+      rtcOccluded1(scene1,&context,&ray2);
+      if (ray2.tfar == float(neg_inf)) return VerifyApplication::FAILED;
+      if (stats.filters != stats1.filters || stats.leaves <= stats1.leaves)
+        return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct BuildConfigTest : public VerifyApplication::Test
+  {
+    std::string config;
+
+    BuildConfigTest (std::string name, int isa, std::string config)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), config(config) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+","+config).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* build high quality scene and geometry BVHs with the default and the tested device configuration */
+      bool passed = true;
+      const RTCSceneFlags flags[2] = { RTC_SCENE_FLAG_NONE, RTC_SCENE_FLAG_DYNAMIC };
+      for (size_t k=0; k<2; k++)
+      {
+        /* randomly sized triangles spread over some region */
+        VerifyScene scene0(device0,SceneFlags(flags[k],RTC_BUILD_QUALITY_HIGH));
+        Ref<SceneGraph::Node> mesh = scene0.addTriangleSoup(sampler,RTC_BUILD_QUALITY_HIGH,20000,[&] (size_t i) {
+            return std::make_pair(100.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)),(i%16 == 0) ? 10.0f : 0.5f);
+          }).second;
+        rtcCommitScene (scene0);
+        AssertNoError(device0);
+
+        VerifyScene scene1(device1,SceneFlags(flags[k],RTC_BUILD_QUALITY_HIGH));
+        scene1.addGeometry2(RTC_BUILD_QUALITY_HIGH,mesh);
+        rtcCommitScene (scene1);
+        AssertNoError(device1);
+
+        /* both configurations have to report the same hits */
+        passed &= sameHits(scene0,scene1,1024,[&] (size_t i) {
+            return makeRay(150.0f*(2.0f*random_Vec3fa()-Vec3fa(1.0f)),2.0f*random_Vec3fa()-Vec3fa(1.0f));
+          });
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct TransmittanceTest : public VerifyApplication::Test
+  {
+    TransmittanceTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* two half transparent planes in front of each other */
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<2; i++) {
+        unsigned int geomID = scene.addPlane(sampler,RTC_BUILD_QUALITY_MEDIUM,4,Vec3fa(-1.0f,-1.0f,float(i)),Vec3fa(2,0,0),Vec3fa(0,2,0)).first;
+        rtcSetGeometryOpacity(rtcGetGeometry(scene,geomID),0.5f);
+        rtcCommitGeometry(rtcGetGeometry(scene,geomID));
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* opacity is ignored without the transmittance flag */
+      float transmittance = 1.0f;
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.transmittance = &transmittance;
+      context.minTransmittance = 0.1f;
+      RTCRay ray0 = makeRay(Vec3fa(0.3f,0.1f,-10.0f),Vec3fa(0,0,1)).ray; ray0.id = 0;
+      rtcOccluded1(scene,&context,&ray0);
+      if (ray0.tfar != float(neg_inf) || transmittance != 1.0f)
+        return VerifyApplication::FAILED;
+
+      /* both planes attenuate the ray, which stays unoccluded */
+      context.flags = (RTCIntersectContextFlags) (context.flags | RTC_INTERSECT_CONTEXT_FLAG_TRANSMITTANCE);
+      RTCRay ray1 = makeRay(Vec3fa(0.3f,0.1f,-10.0f),Vec3fa(0,0,1)).ray; ray1.id = 0;
+      rtcOccluded1(scene,&context,&ray1);
+      if (ray1.tfar == float(neg_inf) || transmittance != 0.25f)
+        return VerifyApplication::FAILED;
+
+      /* the ray gets occluded once its transmittance falls below the threshold */
+      transmittance = 1.0f;
+      context.minTransmittance = 0.3f;
+      RTCRay ray2 = makeRay(Vec3fa(0.3f,0.1f,-10.0f),Vec3fa(0,0,1)).ray; ray2.id = 0;
+      rtcOccluded1(scene,&context,&ray2);
+      if (ray2.tfar != float(neg_inf) || transmittance != 0.25f)
+        return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AdaptiveTessellationTest : public VerifyApplication::Test
+  {
+    AdaptiveTessellationTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      AssertNoError(device);
+
+      /* subdivision sphere tessellated for a camera close to one side */
+      Vec3fa camera(0.0f,0.0f,-1.5f);
+      std::pair<unsigned,Ref<SceneGraph::Node>> sphere = scene.addSubdivSphere(sampler,RTC_BUILD_QUALITY_MEDIUM,zero,1.0f,8,16.0f);
+      unsigned int geomID = sphere.first;
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcSetGeometryAdaptiveTessellation(geom,(float*)&camera,2.0f,16.0f);
+      rtcCommitGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* same sphere uniformly tessellated with the maximal level as reference */
+      VerifyScene refScene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int refGeomID = refScene.addGeometry2(RTC_BUILD_QUALITY_MEDIUM,sphere.second).first;
+      rtcSetGeometryTessellationRate(rtcGetGeometry(refScene,refGeomID),16.0f);
+      rtcCommitGeometry(rtcGetGeometry(refScene,refGeomID));
+      rtcCommitScene (refScene);
+      AssertNoError(device);
+
+      /* the tessellation has to be crack free, thus all rays towards the center hit */
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa p = 0.3f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+        RTCRayHit ray = makeRay(camera,p-camera);
+        rtcIntersect1(scene,&context,&ray);
+        if (ray.hit.geomID != geomID) return VerifyApplication::FAILED;
+      }
+
+      /* average hit distance error against the reference of the side facing the origin */
+      auto tessellationError = [&] (const Vec3fa& org) -> float
+      {
+        float error = 0.0f;
+        for (size_t i=0; i<256; i++)
+        {
+          const Vec3fa p = 0.3f*(2.0f*random_Vec3fa()-Vec3fa(1.0f));
+          RTCRayHit ray0 = makeRay(org,p-org); rtcIntersect1(scene,&context,&ray0);
+          RTCRayHit ray1 = makeRay(org,p-org); rtcIntersect1(refScene,&context,&ray1);
+          if (ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID || ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID) return float(inf);
+          error += abs(ray0.ray.tfar-ray1.ray.tfar);
+        }
+        return error/256.0f;
+      };
+
+      /* edges close to the camera get higher levels, thus the near side is more accurate */
+      const float nearError0 = tessellationError(Vec3fa(0.0f,0.0f,-3.0f));
+      const float farError0  = tessellationError(Vec3fa(0.0f,0.0f,+3.0f));
+      if (!(4.0f*nearError0 < farError0)) return VerifyApplication::FAILED;
+
+      /* moving the camera to the other side swaps the accurate side */
+      camera = Vec3fa(0.0f,0.0f,+1.5f);
+      rtcSetGeometryAdaptiveTessellation(geom,(float*)&camera,2.0f,16.0f);
+      rtcCommitGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      const float nearError1 = tessellationError(Vec3fa(0.0f,0.0f,+3.0f));
+      const float farError1  = tessellationError(Vec3fa(0.0f,0.0f,-3.0f));
+      if (!(4.0f*nearError1 < farError1)) return VerifyApplication::FAILED;
+
+      /* invalid edge level ranges and geometry types are rejected */
+      rtcSetGeometryAdaptiveTessellation(geom,(float*)&camera,16.0f,2.0f);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+      RTCGeometry triangles = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryAdaptiveTessellation(triangles,(float*)&camera,2.0f,16.0f);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      rtcReleaseGeometry(triangles);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  /* node of a BVH built through the callbacks of rtcBuildBVH */
+  struct UserBVHNode
+  {
+    static const size_t MAX_CHILDREN = 4;
+    static const size_t MAX_PRIMS = 4;
+
+    unsigned int numChildren;               //!< number of children, 0 for leaves
+    unsigned int numPrims;                  //!< number of primitives of a leaf
+    UserBVHNode* children[MAX_CHILDREN];
+    BBox3fa bounds[MAX_CHILDREN];           //!< bounds of the children
+    LBBox3fa lbounds[MAX_CHILDREN];         //!< linear bounds of the children of motion blur BVHs
+    BBox1f time[MAX_CHILDREN];              //!< time range of the children of motion blur BVHs
+    unsigned int primIDs[MAX_PRIMS];
+
+    static UserBVHNode* alloc(RTCThreadLocalAllocator alloc, unsigned int numChildren, unsigned int numPrims)
+    {
+      UserBVHNode* node = new (rtcThreadLocalAlloc(alloc,sizeof(UserBVHNode),16)) UserBVHNode;
+      node->numChildren = numChildren;
+      node->numPrims = numPrims;
+      for (size_t i=0; i<MAX_CHILDREN; i++) node->children[i] = nullptr;
+      return node;
+    }
+
+    static void* create (RTCThreadLocalAllocator alloc, unsigned int numChildren, void* userPtr) {
+      return UserBVHNode::alloc(alloc,min(numChildren,(unsigned int)MAX_CHILDREN),0);
+    }
+
+    static void setChildren (void* nodePtr, void** children, unsigned int numChildren, void* userPtr)
+    {
+      for (size_t i=0; i<numChildren && i<MAX_CHILDREN; i++)
+        ((UserBVHNode*)nodePtr)->children[i] = (UserBVHNode*) children[i];
+    }
+
+    static void setBounds (void* nodePtr, const RTCBounds** bounds, unsigned int numChildren, void* userPtr)
+    {
+      for (size_t i=0; i<numChildren && i<MAX_CHILDREN; i++)
+        ((UserBVHNode*)nodePtr)->bounds[i] = *(const BBox3fa*) bounds[i];
+    }
+
+    static void* createLeaf (RTCThreadLocalAllocator alloc, const RTCBuildPrimitive* prims, size_t numPrims, void* userPtr)
+    {
+      UserBVHNode* node = UserBVHNode::alloc(alloc,0,(unsigned int)numPrims);
+      for (size_t i=0; i<numPrims && i<MAX_PRIMS; i++) node->primIDs[i] = prims[i].primID;
+      return node;
+    }
+
+    static void setChildMB (void* nodePtr, unsigned int i, void* child, const RTCLinearBounds* bounds, float timeLower, float timeUpper, void* userPtr)
+    {
+      if (i >= MAX_CHILDREN) return;
+      ((UserBVHNode*)nodePtr)->children[i] = (UserBVHNode*) child;
+      ((UserBVHNode*)nodePtr)->lbounds[i] = *(const LBBox3fa*) bounds;
+      ((UserBVHNode*)nodePtr)->time[i] = BBox1f(timeLower,timeUpper);
+    }
+
+    static void* createLeafMB (RTCThreadLocalAllocator alloc, const RTCBuildPrimitiveMB* prims, size_t numPrims, float timeLower, float timeUpper, void* userPtr)
+    {
+      UserBVHNode* node = UserBVHNode::alloc(alloc,0,(unsigned int)numPrims);
+      for (size_t i=0; i<numPrims && i<MAX_PRIMS; i++) node->primIDs[i] = prims[i].primID;
+      return node;
+    }
+
+    /* checks that all bounds are tight, and counts how often each primitive is referenced */
+    static bool check(const UserBVHNode* node, const std::vector<BBox3fa>& primBounds, std::vector<unsigned int>& primCount, BBox3fa& bounds_o)
+    {
+      bounds_o = empty;
+      if (node->numChildren == 0)
+      {
+        if (node->numPrims == 0 || node->numPrims > MAX_PRIMS) return false;
+        for (size_t i=0; i<node->numPrims; i++) {
+          if (node->primIDs[i] >= primBounds.size()) return false;
+          primCount[node->primIDs[i]]++;
+          bounds_o.extend(primBounds[node->primIDs[i]]);
+        }
+        return true;
+      }
+
+      for (size_t i=0; i<node->numChildren; i++)
+      {
+        BBox3fa cbounds;
+        if (node->children[i] == nullptr) return false;
+        if (!check(node->children[i],primBounds,primCount,cbounds)) return false;
+        if (!(cbounds == node->bounds[i])) return false;
+        bounds_o.extend(cbounds);
+      }
+      return true;
+    }
+
+    /* checks that the bounds at time t contain the primitives, and counts how often each primitive is referenced at that time */
+    static bool checkMB(const UserBVHNode* node, const BBox3fa& bounds, float t, const std::vector<LBBox3fa>& primBounds, std::vector<unsigned int>& primCount)
+    {
+      const BBox3fa ebounds(bounds.lower-Vec3fa(1E-3f),bounds.upper+Vec3fa(1E-3f));
+      if (node->numChildren == 0)
+      {
+        if (node->numPrims == 0 || node->numPrims > MAX_PRIMS) return false;
+        for (size_t i=0; i<node->numPrims; i++) {
+          if (node->primIDs[i] >= primBounds.size()) return false;
+          primCount[node->primIDs[i]]++;
+          if (!subset(primBounds[node->primIDs[i]].interpolate(t),ebounds)) return false;
+        }
+        return true;
+      }
+
+      for (size_t i=0; i<node->numChildren; i++)
+      {
+        if (node->children[i] == nullptr) continue;
+        if (t < node->time[i].lower || t >= node->time[i].upper) continue;
+        const BBox3fa cbounds = node->lbounds[i].interpolate((t-node->time[i].lower)/node->time[i].size());
+        if (!subset(cbounds,ebounds)) return false;
+        if (!checkMB(node->children[i],cbounds,t,primBounds,primCount)) return false;
+      }
+      return true;
+    }
+  };
+
+  /* random build primitives with the primitive ID as index into the bounds array */
+  static void createBuildPrimitives(VerifyApplication::Test* test, size_t N, avector<RTCBuildPrimitive>& prims, std::vector<BBox3fa>& bounds)
+  {
+    prims.resize(N);
+    bounds.resize(N);
+    for (size_t i=0; i<N; i++)
+    {
+      const Vec3fa p = 100.0f*test->random_Vec3fa();
+      bounds[i] = BBox3fa(p,p+test->random_Vec3fa());
+      prims[i].lower_x = bounds[i].lower.x; prims[i].lower_y = bounds[i].lower.y; prims[i].lower_z = bounds[i].lower.z;
+      prims[i].upper_x = bounds[i].upper.x; prims[i].upper_y = bounds[i].upper.y; prims[i].upper_z = bounds[i].upper.z;
+      prims[i].geomID = 0;
+      prims[i].primID = (unsigned int) i;
+    }
+  }
+
+  static RTCBuildArguments userBVHBuildArguments(RTCBVH bvh, RTCBuildQuality quality, avector<RTCBuildPrimitive>& prims)
+  {
+    RTCBuildArguments arguments = rtcDefaultBuildArguments();
+    arguments.byteSize = sizeof(arguments);
+    arguments.buildQuality = quality;
+    arguments.maxBranchingFactor = UserBVHNode::MAX_CHILDREN;
+    arguments.maxLeafSize = UserBVHNode::MAX_PRIMS;
+    arguments.bvh = bvh;
+    arguments.primitives = prims.data();
+    arguments.primitiveCount = prims.size();
+    arguments.primitiveArrayCapacity = prims.size();
+    arguments.createNode = UserBVHNode::create;
+    arguments.setNodeChildren = UserBVHNode::setChildren;
+    arguments.setNodeBounds = UserBVHNode::setBounds;
+    arguments.createLeaf = UserBVHNode::createLeaf;
+    return arguments;
+  }
+
+  static bool checkUserBVH(const UserBVHNode* root, const std::vector<BBox3fa>& primBounds, BBox3fa& bounds_o)
+  {
+    std::vector<unsigned int> primCount(primBounds.size(),0);
+    if (root == nullptr || !UserBVHNode::check(root,primBounds,primCount,bounds_o)) return false;
+    for (size_t i=0; i<primCount.size(); i++)
+      if (primCount[i] != 1) return false;
+    return true;
+  }
+
+  struct UserBVHRefitTest : public VerifyApplication::Test
+  {
+    RTCBuildQuality quality;
+
+    UserBVHRefitTest (std::string name, int isa, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      avector<RTCBuildPrimitive> prims;
+      std::vector<BBox3fa> primBounds;
+      createBuildPrimitives(this,10000,prims,primBounds);
+
+      /* build BVH that records its topology for refitting */
+      RTCBVH bvh = rtcNewBVH(device);
+      RTCBuildArguments arguments = userBVHBuildArguments(bvh,quality,prims);
+      arguments.buildFlags = RTC_BUILD_FLAG_REFIT;
+      UserBVHNode* root = (UserBVHNode*) rtcBuildBVH(&arguments);
+      AssertNoError(device);
+      BBox3fa rootBounds;
+      bool passed = checkUserBVH(root,primBounds,rootBounds);
+
+      /* move the primitives, which got reordered by the builder, and refit */
+      for (size_t i=0; i<prims.size(); i++)
+      {
+        const unsigned int primID = prims[i].primID;
+        const Vec3fa p = 100.0f*random_Vec3fa();
+        primBounds[primID] = BBox3fa(p,p+random_Vec3fa());
+        prims[i].lower_x = primBounds[primID].lower.x; prims[i].lower_y = primBounds[primID].lower.y; prims[i].lower_z = primBounds[primID].lower.z;
+        prims[i].upper_x = primBounds[primID].upper.x; prims[i].upper_y = primBounds[primID].upper.y; prims[i].upper_z = primBounds[primID].upper.z;
+      }
+      rtcRefitBVH(bvh,prims.data(),UserBVHNode::setBounds,nullptr);
+      AssertNoError(device);
+      BBox3fa refitBounds;
+      passed &= checkUserBVH(root,primBounds,refitBounds);
+
+      /* the refitted BVH has to bound the moved primitives like a fresh build */
+      RTCBVH bvh1 = rtcNewBVH(device);
+      avector<RTCBuildPrimitive> prims1 = prims;
+      RTCBuildArguments arguments1 = userBVHBuildArguments(bvh1,quality,prims1);
+      UserBVHNode* root1 = (UserBVHNode*) rtcBuildBVH(&arguments1);
+      AssertNoError(device);
+      BBox3fa freshBounds;
+      passed &= checkUserBVH(root1,primBounds,freshBounds);
+      passed &= refitBounds == freshBounds;
+
+      rtcReleaseBVH(bvh1);
+      rtcReleaseBVH(bvh);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
     }
   };
-  
-  struct UpdateTest : public VerifyApplication::IntersectTest
+
+  struct UserBVHFlatTest : public VerifyApplication::Test
   {
-    SceneFlags sflags;
     RTCBuildQuality quality;
 
-    UpdateTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
-      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
-    
-    static void move_mesh(RTCGeometry mesh, size_t numVertices, Vec3fa& pos) 
+    UserBVHFlatTest (std::string name, int isa, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), quality(quality) {}
+
+    static BBox3fa nodeBounds(const RTCBuildNode& node) {
+      return BBox3fa(Vec3fa(node.lower_x,node.lower_y,node.lower_z),Vec3fa(node.upper_x,node.upper_y,node.upper_z));
+    }
+
+    static BBox3fa primBounds(const RTCBuildPrimitive& prim) {
+      return BBox3fa(Vec3fa(prim.lower_x,prim.lower_y,prim.lower_z),Vec3fa(prim.upper_x,prim.upper_y,prim.upper_z));
+    }
+
+    /* checks that children are stored behind their parent and that all bounds are tight */
+    static bool check(const RTCBuildNode* nodes, size_t numNodes, size_t index, const avector<RTCBuildPrimitive>& prims,
+                      std::vector<unsigned int>& nodeCount, std::vector<unsigned int>& slotCount, BBox3fa& bounds_o)
     {
-      Vec3fa* vertices = (Vec3fa*) rtcGetGeometryBufferData(mesh,RTC_BUFFER_TYPE_VERTEX,0);
-      for (size_t i=0; i<numVertices; i++)
-        vertices[i] += Vec3fa(pos);
-      rtcUpdateGeometryBuffer(mesh,RTC_BUFFER_TYPE_VERTEX,0);
-      rtcCommitGeometry(mesh);
+      bounds_o = empty;
+      if (index >= numNodes) return false;
+      nodeCount[index]++;
+
+      const RTCBuildNode& node = nodes[index];
+      if (node.count & RTC_BUILD_NODE_LEAF)
+      {
+        const size_t N = node.count & ~RTC_BUILD_NODE_LEAF;
+        if (N == 0 || N > UserBVHNode::MAX_PRIMS || size_t(node.offset)+N > prims.size()) return false;
+        for (size_t i=node.offset; i<node.offset+N; i++) {
+          slotCount[i]++;
+          bounds_o.extend(primBounds(prims[i]));
+        }
+        return true;
+      }
+
+      if (node.count < 2 || node.count > UserBVHNode::MAX_CHILDREN || node.offset <= index || size_t(node.offset)+node.count > numNodes) return false;
+      for (size_t i=node.offset; i<node.offset+node.count; i++)
+      {
+        BBox3fa cbounds;
+        if (!check(nodes,numNodes,i,prims,nodeCount,slotCount,cbounds)) return false;
+        if (!(cbounds == nodeBounds(nodes[i]))) return false;
+        bounds_o.extend(cbounds);
+      }
+      return true;
     }
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
@@ -1646,62 +2944,162 @@ namespace embree
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-      if (!supportsIntersectMode(device,imode))
-        return VerifyApplication::SKIPPED;
-      
-      VerifyScene scene(device,sflags);
+
+      avector<RTCBuildPrimitive> prims;
+      std::vector<BBox3fa> bounds;
+      createBuildPrimitives(this,10000,prims,bounds);
+
+      RTCBVH bvh = rtcNewBVH(device);
+      avector<RTCBuildNode> nodes(2*prims.size());
+      RTCBuildArguments arguments = userBVHBuildArguments(bvh,quality,prims);
+      arguments.createNode = nullptr;
+      arguments.setNodeChildren = nullptr;
+      arguments.setNodeBounds = nullptr;
+      arguments.createLeaf = nullptr;
+      arguments.nodes = nodes.data();
+      arguments.nodeArrayCapacity = nodes.size();
+      void* root = rtcBuildBVH(&arguments);
+      const size_t numNodes = rtcGetBVHNodeCount(bvh);
       AssertNoError(device);
-      size_t numPhi = 10;
-      size_t numVertices = 2*numPhi*(numPhi+1);
-      Vec3fa pos0 = Vec3fa(-10,0,-10);
-      Vec3fa pos1 = Vec3fa(-10,0,+10);
-      Vec3fa pos2 = Vec3fa(+10,0,-10);
-      Vec3fa pos3 = Vec3fa(+10,0,+10);
-      unsigned geom0 = scene.addSphere      (sampler,quality,pos0,1.0f,numPhi).first;
-      unsigned geom1 = scene.addQuadSphere  (sampler,quality,pos1,1.0f,numPhi).first;
-      unsigned geom2 = scene.addSubdivSphere(sampler,quality,pos2,1.0f,numPhi,4).first;
-      unsigned geom3 = scene.addSphereHair  (sampler,quality,pos3,1.0f).first;
-      RTCGeometry hgeom0 = rtcGetGeometry(scene,geom0);
-      RTCGeometry hgeom1 = rtcGetGeometry(scene,geom1);
-      RTCGeometry hgeom2 = rtcGetGeometry(scene,geom2);
-      RTCGeometry hgeom3 = rtcGetGeometry(scene,geom3);
+      bool passed = root == nodes.data() && numNodes > 0 && numNodes <= nodes.size();
+
+      /* the root is stored at index 0, and each node and primitive is referenced exactly once */
+      std::vector<unsigned int> nodeCount(numNodes,0);
+      std::vector<unsigned int> slotCount(prims.size(),0);
+      std::vector<unsigned int> primCount(prims.size(),0);
+      BBox3fa rootBounds;
+      passed = passed && check(nodes.data(),numNodes,0,prims,nodeCount,slotCount,rootBounds);
+      passed = passed && rootBounds == nodeBounds(nodes[0]);
+      for (size_t i=0; passed && i<numNodes; i++)
+        passed &= nodeCount[i] == 1;
+      for (size_t i=0; passed && i<prims.size(); i++)
+      {
+        passed &= slotCount[i] == 1 && prims[i].primID < prims.size();
+        passed = passed && primBounds(prims[i]) == bounds[prims[i].primID] && primCount[prims[i].primID]++ == 0;
+      }
+
+      rtcReleaseBVH(bvh);
       AssertNoError(device);
-      
-      for (size_t i=0; i<16; i++) 
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct UserBVHMotionBlurTest : public VerifyApplication::Test
+  {
+    UserBVHMotionBlurTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* linearly moving primitives with up to 4 time segments */
+      const size_t N = 10000;
+      avector<RTCBuildPrimitiveMB> prims(N);
+      std::vector<LBBox3fa> primBounds(N);
+      for (size_t i=0; i<N; i++)
       {
-        bool move0 = i & 1, move1 = i & 2, move2 = i & 4, move3 = i & 8;
-        Vec3fa ds(2,0.1f,2,0.0f);
-        if (move0) { move_mesh(hgeom0,numVertices,ds); pos0 += ds; }
-        if (move1) { move_mesh(hgeom1,numVertices,ds); pos1 += ds; }
-        if (move2) { move_mesh(hgeom2,numVertices,ds); pos2 += ds; }
-        if (move3) { move_mesh(hgeom3,4,ds); pos3 += ds; }
-        rtcCommitScene (scene);
-        AssertNoError(device);
+        const Vec3fa p0 = 100.0f*random_Vec3fa();
+        const Vec3fa p1 = p0 + 10.0f*random_Vec3fa();
+        const Vec3fa size = random_Vec3fa();
+        primBounds[i] = LBBox3fa(BBox3fa(p0,p0+size),BBox3fa(p1,p1+size));
+        (LBBox3fa&) prims[i].bounds = primBounds[i];
+        prims[i].geomID = 0;
+        prims[i].primID = (unsigned int) i;
+        prims[i].timeSegmentCount = 1+(unsigned int)(random_int() & 3);
+      }
 
-        RTCRayHit ray0 = makeRay(pos0+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 0
-        RTCRayHit ray1 = makeRay(pos1+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 1
-        RTCRayHit ray2 = makeRay(pos2+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 2
-        RTCRayHit ray3 = makeRay(pos3+Vec3fa(0,10,0),Vec3fa(0,-1,0)); // hits geomID == 3
-        RTCRayHit testRays[4] = { ray0, ray1, ray2, ray3 };
+      RTCBVH bvh = rtcNewBVH(device);
+      RTCBuildArguments arguments = rtcDefaultBuildArguments();
+      arguments.byteSize = sizeof(arguments);
+      arguments.maxBranchingFactor = UserBVHNode::MAX_CHILDREN;
+      arguments.maxLeafSize = UserBVHNode::MAX_PRIMS;
+      arguments.bvh = bvh;
+      arguments.primitivesMB = prims.data();
+      arguments.primitiveCount = prims.size();
+      arguments.primitiveArrayCapacity = prims.size();
+      arguments.createNode = UserBVHNode::create;
+      arguments.setNodeChildMB = UserBVHNode::setChildMB;
+      arguments.createLeafMB = UserBVHNode::createLeafMB;
+      UserBVHNode* root = (UserBVHNode*) rtcBuildBVH(&arguments);
+      AssertNoError(device);
 
-        const unsigned int maxRays = 100;
-        RTCRayHit rays[maxRays];
-        for (unsigned int numRays=1; numRays<maxRays; numRays++) {
-          for (size_t i=0; i<numRays; i++) rays[i] = testRays[i%4];
-          IntersectWithMode(imode,ivariant,scene,rays,numRays);
-          for (size_t i=0; i<numRays; i++)
-            if (ivariant & VARIANT_INTERSECT) {
-              if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID)
-                return VerifyApplication::FAILED;
-            }
-            else {
-              if (rays[i].ray.tfar != float(neg_inf))
-                return VerifyApplication::FAILED;
-            }
-        }
+      /* at each time, the nodes valid for that time have to reference each primitive exactly once */
+      bool passed = root != nullptr;
+      const float times[] = { 0.1f, 0.4f, 0.6f, 0.9f };
+      for (float t : times)
+      {
+        std::vector<unsigned int> primCount(N,0);
+        passed = passed && UserBVHNode::checkMB(root,BBox3fa(Vec3fa(-1E10f),Vec3fa(1E10f)),t,primBounds,primCount);
+        for (size_t i=0; passed && i<N; i++)
+          passed &= primCount[i] == 1;
+      }
+
+      rtcReleaseBVH(bvh);
+      AssertNoError(device);
+      return passed ? VerifyApplication::PASSED : VerifyApplication::FAILED;
+    }
+  };
+
+  struct UserBVHErrorTest : public VerifyApplication::Test
+  {
+    UserBVHErrorTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      avector<RTCBuildPrimitive> prims;
+      std::vector<BBox3fa> bounds;
+      createBuildPrimitives(this,100,prims,bounds);
+      avector<RTCBuildPrimitiveMB> primsMB(prims.size());
+      for (size_t i=0; i<prims.size(); i++) {
+        (LBBox3fa&) primsMB[i].bounds = LBBox3fa(bounds[i]);
+        primsMB[i].geomID = 0;
+        primsMB[i].primID = (unsigned int) i;
+        primsMB[i].timeSegmentCount = 1;
       }
+      avector<RTCBuildNode> nodes(2*prims.size());
+      RTCBVH bvh = rtcNewBVH(device);
+
+      /* motion blur BVHs cannot get refitted */
+      RTCBuildArguments arguments = userBVHBuildArguments(bvh,RTC_BUILD_QUALITY_MEDIUM,prims);
+      arguments.buildFlags = RTC_BUILD_FLAG_REFIT;
+      arguments.primitivesMB = primsMB.data();
+      arguments.setNodeChildMB = UserBVHNode::setChildMB;
+      arguments.createLeafMB = UserBVHNode::createLeafMB;
+      rtcBuildBVH(&arguments);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      /* flat BVHs cannot get refitted */
+      arguments = userBVHBuildArguments(bvh,RTC_BUILD_QUALITY_MEDIUM,prims);
+      arguments.buildFlags = RTC_BUILD_FLAG_REFIT;
+      arguments.nodes = nodes.data();
+      arguments.nodeArrayCapacity = nodes.size();
+      rtcBuildBVH(&arguments);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      /* the node array has to hold twice the number of primitives */
+      arguments = userBVHBuildArguments(bvh,RTC_BUILD_QUALITY_MEDIUM,prims);
+      arguments.nodes = nodes.data();
+      arguments.nodeArrayCapacity = nodes.size()-1;
+      rtcBuildBVH(&arguments);
+      AssertError(device,RTC_ERROR_INVALID_ARGUMENT);
+
+      /* BVHs built without the refit flag cannot get refitted */
+      arguments = userBVHBuildArguments(bvh,RTC_BUILD_QUALITY_MEDIUM,prims);
+      rtcBuildBVH(&arguments);
       AssertNoError(device);
+      rtcRefitBVH(bvh,prims.data(),UserBVHNode::setBounds,nullptr);
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
 
+      rtcReleaseBVH(bvh);
+      AssertNoError(device);
       return VerifyApplication::PASSED;
     }
   };
@@ -1963,6 +3361,18 @@ namespace embree
       passed &= checkSubdivInterpolation(device,geom,RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE,0,user_vertices0.data(),1,N);
       passed &= checkSubdivInterpolation(device,geom,RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE,1,user_vertices1.data(),1,N);
 
+      /* interpolating the same face again has to hit the tessellation cache of the device */
+      if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+      {
+        float P[256];
+        const ssize_t hits0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+        rtcInterpolate1(geom,0,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE,0,P,nullptr,nullptr,(unsigned int)N);
+        rtcInterpolate1(geom,0,0.25f,0.75f,RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE,0,P,nullptr,nullptr,(unsigned int)N);
+        const ssize_t hits1 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+        const ssize_t misses = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+        passed &= hits1 > hits0 && misses > 0;
+      }
+
       rtcReleaseGeometry(geom);
       AssertNoError(device);
 
@@ -2419,6 +3829,92 @@ namespace embree
     }
   };
   
+  struct MultiLevelInstancingTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags; 
+    RTCBuildQuality quality; 
+
+    MultiLevelInstancingTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+     
+      Vec3f vertices[4] = {
+        Vec3f(-1.0f,-1.0f,0.0f),
+        Vec3f(+1.0f,-1.0f,0.0f),
+        Vec3f(-1.0f,+1.0f,0.0f),
+        Vec3f(zero) // dummy vertex for 16 byte padding
+      };
+      Triangle triangles[1] = {
+        Triangle(0,1,2)
+      };
+
+      /* innermost scene contains a single triangle */
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,quality);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, vertices , 0, sizeof(Vec3f), 3);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3,  triangles, 0, sizeof(Triangle), 1);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+
+      /* each further level instantiates the previous one with a
+       * translation by one unit along z and geomID equal to its level */
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0.0f,0.0f,1.0f));
+      for (unsigned int l=1; l<=RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+      {
+        RTCScene parent = rtcNewScene(device);
+        rtcSetSceneFlags(parent,sflags.sflags);
+        rtcSetSceneBuildQuality(parent,sflags.qflags);
+        RTCGeometry inst = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_INSTANCE);
+        rtcSetGeometryInstancedScene(inst,scene);
+        rtcSetGeometryTransform(inst,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,(float*)&xfm);
+        rtcCommitGeometry(inst);
+        rtcAttachGeometryByID(parent,inst,l);
+        rtcReleaseGeometry(inst);
+        rtcCommitScene (parent);
+        scene = parent; // instance keeps the child scene alive
+      }
+      AssertNoError(device);
+
+      RTCRayHit rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org(0.5f*random_float()-0.5f,0.5f*random_float()-0.5f,-1.0f);
+        rays[i] = makeRay(org,Vec3fa(0.0f,0.0f,1.0f));
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT)) 
+        {
+          if (rays[i].ray.tfar != float(neg_inf)) return VerifyApplication::FAILED;          
+          continue;
+        }
+
+        if (rays[i].hit.geomID != 0) return VerifyApplication::FAILED;
+        if (rays[i].hit.primID != 0) return VerifyApplication::FAILED;
+        for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+          if (rays[i].hit.instID[l] != RTC_MAX_INSTANCE_LEVEL_COUNT-l) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - float(RTC_MAX_INSTANCE_LEVEL_COUNT+1)) > 16.0f*float(ulp)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     SceneFlags sflags; 
@@ -2689,6 +4185,57 @@ namespace embree
     }
   };
 
+  struct StreamSortingTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    StreamSortingTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",stream_sort_size=64";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene(device,sflags);
+      for (size_t i=0; i<16; i++) {
+        const Vec3fa center = 8.0f*random_Vec3fa()-Vec3fa(4.0f);
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(center,0.5f,10));
+      }
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* sorted streams have to produce the same hits as single rays */
+      RTCRayHit rays[256], refs[256];
+      for (size_t i=0; i<256; i++)
+      {
+        const Vec3fa org = 10.0f*random_Vec3fa()-Vec3fa(5.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        rays[i] = refs[i] = (i%7 == 0) ? makeRay(org,dir,1.0f,0.0f) : makeRay(org,dir);
+      }
+      IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene,refs,256);
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (!(ivariant & VARIANT_INTERSECT))
+        {
+          if ((rays[i].ray.tfar == float(neg_inf)) != (refs[i].hit.geomID != RTC_INVALID_GEOMETRY_ID)) return VerifyApplication::FAILED;
+          continue;
+        }
+        if (rays[i].hit.geomID != refs[i].hit.geomID) return VerifyApplication::FAILED;
+        if (rays[i].hit.primID != refs[i].hit.primID) return VerifyApplication::FAILED;
+        if (abs(rays[i].ray.tfar - refs[i].ray.tfar) > 1E-5f*abs(refs[i].ray.tfar)) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct WatertightTest : public VerifyApplication::IntersectTest
   {
     ALIGNED_STRUCT_(16);
@@ -4228,6 +5775,7 @@ namespace embree
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
+    sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_QUANTIZED,     RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_NONE,       RTC_BUILD_QUALITY_HIGH));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_MEDIUM));
@@ -4313,6 +5861,38 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
       groups.pop();
+
+      push(new TestGroup("save_load_scene",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new SaveLoadSceneTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("commit_scene_async",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CommitSceneAsyncTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("quantized_scene",true,true));
+      for (auto imode : intersectModes)
+        for (auto ivariant : intersectVariants)
+          if (has_variant(imode,ivariant))
+            groups.top()->add(new QuantizedSceneTest(to_string(imode,ivariant),isa,imode,ivariant));
+      groups.pop();
+
+      push(new TestGroup("point_query",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("collide",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CollideTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("compressed_vertices",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new CompressedVerticesTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,false));
       for (auto sflags : sceneFlags)
@@ -4347,6 +5927,36 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("incremental_update",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new IncrementalUpdateTest("deformable."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT));
+        groups.top()->add(new IncrementalUpdateTest("dynamic."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_LOW));
+      }
+      groups.pop();
+
+      groups.top()->add(new MortonCode64Test("morton_code64",isa));
+
+      GeometryType gtypes_refit[] = { TRIANGLE_MESH_MB, QUAD_MESH_MB, GRID_MESH, HAIR_GEOMETRY };
+      push(new TestGroup("scene_refit",true,true));
+      for (auto gtype : gtypes_refit)
+        groups.top()->add(new SceneRefitTest(to_string(gtype),isa,gtype));
+      groups.pop();
+
+      groups.top()->add(new BuildConfigTest("restructure",isa,"restructure_passes=2"));
+      groups.top()->add(new BuildConfigTest("node_clustering",isa,"node_clustering_threshold=0"));
+
+      groups.top()->add(new TraversalStatisticsTest("traversal_statistics",isa));
+      groups.top()->add(new AdaptiveTessellationTest("adaptive_tessellation",isa));
+
+      push(new TestGroup("user_bvh",true,true));
+      for (auto quality : { RTC_BUILD_QUALITY_LOW, RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_HIGH }) {
+        groups.top()->add(new UserBVHRefitTest("refit."+to_string(quality),isa,quality));
+        groups.top()->add(new UserBVHFlatTest("flat."+to_string(quality),isa,quality));
+      }
+      groups.top()->add(new UserBVHMotionBlurTest("motion_blur",isa));
+      groups.top()->add(new UserBVHErrorTest("errors",isa));
+      groups.pop();
+
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom",isa));
 #endif
@@ -4409,6 +6019,14 @@ namespace embree
             if (has_variant(imode,ivariant))
                 groups.top()->add(new TriangleHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
+
+      push(new TestGroup("stream_sorting",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new StreamSortingTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+      groups.pop();
       
       push(new TestGroup("quad_hit",true,true));
       for (auto sflags : sceneFlags) 
@@ -4418,6 +6036,14 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("multi_level_instancing",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+                groups.top()->add(new MultiLevelInstancingTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
+      groups.pop();
+
       if (rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_RAY_MASK_SUPPORTED)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -4456,6 +6082,8 @@ namespace embree
             for (auto ivariant : intersectVariants)
               if (has_variant(imode,ivariant))
                   groups.top()->add(new IntersectionFilterTest("subdiv."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
+
+        groups.top()->add(new TransmittanceTest("transmittance",isa));
       }
       groups.pop();
       